@@ -34,6 +34,7 @@ void pl_cleanup_metal             (void);
 void pl_create_metal_font_texture (plFontAtlas* ptAtlas);
 void pl_cleanup_metal_font_texture(plFontAtlas* ptAtlas);
 void pl_new_draw_frame_metal      (MTLRenderPassDescriptor* renderPassDescriptor);
+void pl_record_metal_font_updates (id<MTLCommandBuffer> commandBuffer); // after pl_render(), before the render encoder is created
 void pl_submit_metal_drawlist     (plDrawList* ptDrawlist, float fWidth, float fHeight, id<MTLRenderCommandEncoder> renderEncoder, id<MTLCommandBuffer> commandBuffer, MTLRenderPassDescriptor* renderPassDescriptor);
 NS_ASSUME_NONNULL_END
 
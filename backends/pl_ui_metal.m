@@ -100,72 +100,82 @@ pl_new_draw_frame_metal(MTLRenderPassDescriptor* renderPassDescriptor2)
 }
 
 void
-pl_submit_metal_drawlist(plDrawList* drawlist, float width, float height, id<MTLRenderCommandEncoder> renderEncoder, id<MTLCommandBuffer> commandBuffer, MTLRenderPassDescriptor* renderPassDescriptor2)
+pl_record_metal_font_updates(id<MTLCommandBuffer> commandBuffer)
 {
     plUiContext* ptCtx = pl_get_context();
     MetalContext* metalCtx = ptCtx->tIO.pBackendRendererData;
-    
-
-    // ensure gpu vertex buffer size is adequate
-    size_t vertexBufferLength = (size_t)plu_sb_size(drawlist->sbtVertexBuffer) * sizeof(plDrawVertex);
-    size_t indexBufferLength = (size_t)drawlist->uIndexBufferByteSize;
 
-    if(indexBufferLength == 0)
+    // glyphs rasterized on demand by dynamic fonts
+    plFontAtlas* atlas = ptCtx->fontAtlas;
+    if(atlas == NULL || plu_sb_size(atlas->sbtDirtyRects) == 0)
         return;
-    MetalBuffer* vertexBuffer = [metalCtx dequeueReusableBufferOfLength:vertexBufferLength device:metalCtx.device];
-    MetalBuffer* indexBuffer = [metalCtx dequeueReusableBufferOfLength:indexBufferLength device:metalCtx.device];
 
-    // copy vertex data to gpu
-    memcpy(vertexBuffer.buffer.contents, drawlist->sbtVertexBuffer, sizeof(plDrawVertex) * plu_sb_size(drawlist->sbtVertexBuffer));
+    const NSUInteger bytesPerPixel = atlas->bAlpha8Only ? 1 : 4;
+    const unsigned char* pixels = atlas->bAlpha8Only ? atlas->pucPixelsAsAlpha8 : atlas->pucPixelsAsRGBA32;
 
-    // index GPU data transfer
-    uint32_t uTempIndexBufferOffset = 0u;  
-    uint32_t globalIdxBufferIndexOffset = 0u;
+    // rects are packed one after another (4 byte aligned) in a staging buffer
+    NSUInteger stagingBufferLength = 0;
+    for(uint32_t i = 0; i < plu_sb_size(atlas->sbtDirtyRects); i++)
+        stagingBufferLength += (atlas->sbtDirtyRects[i].uWidth * atlas->sbtDirtyRects[i].uHeight * bytesPerPixel + 3) & ~(NSUInteger)3;
+    MetalBuffer* stagingBuffer = [metalCtx dequeueReusableBufferOfLength:stagingBufferLength device:metalCtx.device];
 
-    for(uint32_t i = 0u; i < plu_sb_size(drawlist->sbtSubmittedLayers); i++)
+    // copied on the gpu timeline so frames still in flight keep sampling the old pixels
+    id<MTLBlitCommandEncoder> blitEncoder = [commandBuffer blitCommandEncoder];
+    unsigned char* stage = stagingBuffer.buffer.contents;
+    NSUInteger stagingOffset = 0;
+    for(uint32_t i = 0; i < plu_sb_size(atlas->sbtDirtyRects); i++)
     {
-        plDrawCommand* lastCommand = NULL;
-        plDrawLayer* layer = drawlist->sbtSubmittedLayers[i];
+        const plFontAtlasRect* rect = &atlas->sbtDirtyRects[i];
+        const NSUInteger rowSize = rect->uWidth * bytesPerPixel;
+        for(uint32_t y = 0; y < rect->uHeight; y++)
+            memcpy(&stage[stagingOffset + y * rowSize], &pixels[((rect->uY + y) * atlas->auAtlasSize[0] + rect->uX) * bytesPerPixel], rowSize);
+
+        [blitEncoder copyFromBuffer:stagingBuffer.buffer
+                        sourceOffset:stagingOffset
+                   sourceBytesPerRow:rowSize
+                 sourceBytesPerImage:rowSize * rect->uHeight
+                          sourceSize:MTLSizeMake(rect->uWidth, rect->uHeight, 1)
+                           toTexture:metalCtx.fontTexture
+                    destinationSlice:0
+                    destinationLevel:0
+                   destinationOrigin:MTLOriginMake(rect->uX, rect->uY, 0)];
+        stagingOffset += (rowSize * rect->uHeight + 3) & ~(NSUInteger)3;
+    }
+    [blitEncoder endEncoding];
+    plu_sb_reset(atlas->sbtDirtyRects);
 
-        unsigned char* destination = indexBuffer.buffer.contents;
-        memcpy(&destination[uTempIndexBufferOffset], layer->sbuIndexBuffer, sizeof(uint32_t) * plu_sb_size(layer->sbuIndexBuffer));
+    [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> tCmdBuffer)
+    {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            @synchronized(metalCtx.bufferCache)
+            {
+                [metalCtx.bufferCache addObject:stagingBuffer];
+            }
+        });
+    }];
+}
 
-        uTempIndexBufferOffset += plu_sb_size(layer->sbuIndexBuffer) * sizeof(uint32_t);
+void
+pl_submit_metal_drawlist(plDrawList* drawlist, float width, float height, id<MTLRenderCommandEncoder> renderEncoder, id<MTLCommandBuffer> commandBuffer, MTLRenderPassDescriptor* renderPassDescriptor2)
+{
+    plUiContext* ptCtx = pl_get_context();
+    MetalContext* metalCtx = ptCtx->tIO.pBackendRendererData;
 
-        // attempt to merge commands
-        for(uint32_t j = 0u; j < plu_sb_size(layer->sbtCommandBuffer); j++)
-        {
-            plDrawCommand *layerCommand = &layer->sbtCommandBuffer[j];
-            bool bCreateNewCommand = true;
+    // merge layers into final commands & single vertex/index buffers
+    pl_compile_drawlist(drawlist);
 
-            if(lastCommand)
-            {
-                // check for same texture (allows merging draw calls)
-                if(lastCommand->tTextureId == layerCommand->tTextureId && lastCommand->bSdf == layerCommand->bSdf)
-                {
-                    lastCommand->uElementCount += layerCommand->uElementCount;
-                    bCreateNewCommand = false;
-                }
+    // ensure gpu vertex buffer size is adequate
+    size_t vertexBufferLength = (size_t)plu_sb_size(drawlist->sbtVertexBuffer) * sizeof(plDrawVertex);
+    size_t indexBufferLength = (size_t)drawlist->uIndexBufferByteSize;
 
-                // check for same clipping (allows merging draw calls)
-                if(layerCommand->tClip.tMax.x != lastCommand->tClip.tMax.x || layerCommand->tClip.tMax.y != lastCommand->tClip.tMax.y ||
-                    layerCommand->tClip.tMin.x != lastCommand->tClip.tMin.x || layerCommand->tClip.tMin.y != lastCommand->tClip.tMin.y)
-                {
-                    bCreateNewCommand = true;
-                }
-            }
+    if(indexBufferLength == 0)
+        return;
+    MetalBuffer* vertexBuffer = [metalCtx dequeueReusableBufferOfLength:vertexBufferLength device:metalCtx.device];
+    MetalBuffer* indexBuffer = [metalCtx dequeueReusableBufferOfLength:indexBufferLength device:metalCtx.device];
 
-            if(bCreateNewCommand)
-            {
-                layerCommand->uIndexOffset = globalIdxBufferIndexOffset + layerCommand->uIndexOffset;
-                plu_sb_push(drawlist->sbtDrawCommands, *layerCommand);       
-                lastCommand = layerCommand;
-  
-            }
-            
-        }    
-        globalIdxBufferIndexOffset += plu_sb_size(layer->sbuIndexBuffer);    
-    }
+    // copy vertex & index data to gpu
+    memcpy(vertexBuffer.buffer.contents, drawlist->sbtVertexBuffer, vertexBufferLength);
+    memcpy(indexBuffer.buffer.contents, drawlist->sbuIndexBuffer, indexBufferLength);
     
     // Try to retrieve a render pipeline state that is compatible with the framebuffer config for this frame
     // The hit rate for this cache should be very near 100%.
@@ -286,6 +296,14 @@ pl_create_metal_font_texture(plFontAtlas* atlas)
     // an 8-bit unsigned normalized value (i.e. 0 maps to 0.0 and 255 maps to 1.0)
     metalCtx.textureDescriptor.pixelFormat = MTLPixelFormatRGBA8Unorm;
 
+    // alpha8 only atlas: single channel, sampled as white with coverage in alpha
+    // (the sdf fragment shader reads its distance from .a, so the swizzle covers both)
+    if(atlas->bAlpha8Only)
+    {
+        metalCtx.textureDescriptor.pixelFormat = MTLPixelFormatR8Unorm;
+        metalCtx.textureDescriptor.swizzle = MTLTextureSwizzleChannelsMake(MTLTextureSwizzleOne, MTLTextureSwizzleOne, MTLTextureSwizzleOne, MTLTextureSwizzleRed);
+    }
+
     // Set the pixel dimensions of the texture
     metalCtx.textureDescriptor.width = atlas->auAtlasSize[0];
     metalCtx.textureDescriptor.height = atlas->auAtlasSize[1];
@@ -299,11 +317,12 @@ pl_create_metal_font_texture(plFontAtlas* atlas)
         {atlas->auAtlasSize[0], atlas->auAtlasSize[1], 1}    // MTLSize
     };
 
-    NSUInteger bytesPerRow = 4 * atlas->auAtlasSize[0];
+    const NSUInteger bytesPerPixel = atlas->bAlpha8Only ? 1 : 4;
+    NSUInteger bytesPerRow = bytesPerPixel * atlas->auAtlasSize[0];
 
     [metalCtx.fontTexture replaceRegion:region
                 mipmapLevel:0
-                withBytes:atlas->pucPixelsAsRGBA32
+                withBytes:atlas->bAlpha8Only ? atlas->pucPixelsAsAlpha8 : atlas->pucPixelsAsRGBA32
                 bytesPerRow:bytesPerRow];
 
     ptCtx->fontAtlas->tTexture = metalCtx.fontTexture;
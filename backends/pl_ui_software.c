@@ -0,0 +1,454 @@
+/*
+   pl_ui_software.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] structs
+// [SECTION] internal api
+// [SECTION] public api implementation
+// [SECTION] internal api implementation
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_ui_software.h"
+#include "pl_ui_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plSoftwareTarget
+{
+    unsigned char* pucPixels;
+    uint32_t       uWidth;
+    uint32_t       uHeight;
+    int            iClipMinX;
+    int            iClipMinY;
+    int            iClipMaxX; // exclusive
+    int            iClipMaxY; // exclusive
+} plSoftwareTarget;
+
+typedef struct _plSoftwareDrawContext
+{
+    // fonts
+    plSoftwareTexture   tFontTexture;
+
+    // user textures (individually allocated so handles stay valid)
+    plSoftwareTexture** sbtTextures;
+
+    // stats
+    plSoftwareStats     tStats;
+} plSoftwareDrawContext;
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api
+//-----------------------------------------------------------------------------
+
+static void pl__sample_software_texture(const plSoftwareTexture* ptTexture, float fU, float fV, float* afColorOut);
+static void pl__rasterize_triangle     (plSoftwareDrawContext* ptCtx, plSoftwareTarget* ptTarget, const plSoftwareTexture* ptTexture, bool bSdf, const plDrawVertex* ptV0, const plDrawVertex* ptV1, const plDrawVertex* ptV2);
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api implementation
+//-----------------------------------------------------------------------------
+
+void
+pl_initialize_software(void)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = malloc(sizeof(plSoftwareDrawContext));
+    memset(ptSoftwareDrawCtx, 0, sizeof(plSoftwareDrawContext));
+    ptCtx->tIO.pBackendRendererData = ptSoftwareDrawCtx;
+}
+
+void
+pl_cleanup_software(void)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    for(uint32_t i = 0; i < plu_sb_size(ptSoftwareDrawCtx->sbtTextures); i++)
+        free(ptSoftwareDrawCtx->sbtTextures[i]);
+    plu_sb_free(ptSoftwareDrawCtx->sbtTextures);
+    free(ptSoftwareDrawCtx);
+    ptCtx->tIO.pBackendRendererData = NULL;
+}
+
+void
+pl_create_software_font_texture(plFontAtlas* ptAtlas)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    ptCtx->fontAtlas = ptAtlas;
+
+    // the atlas is white with coverage in alpha, so sampling the
+    // single channel copy is equivalent and 4x lighter on cache
+    if(ptAtlas->pucPixelsAsAlpha8)
+    {
+        ptSoftwareDrawCtx->tFontTexture.pucData   = ptAtlas->pucPixelsAsAlpha8;
+        ptSoftwareDrawCtx->tFontTexture.uChannels = 1u;
+    }
+    else
+    {
+        ptSoftwareDrawCtx->tFontTexture.pucData   = ptAtlas->pucPixelsAsRGBA32;
+        ptSoftwareDrawCtx->tFontTexture.uChannels = 4u;
+    }
+    ptSoftwareDrawCtx->tFontTexture.uWidth  = ptAtlas->auAtlasSize[0];
+    ptSoftwareDrawCtx->tFontTexture.uHeight = ptAtlas->auAtlasSize[1];
+
+    ptAtlas->tTexture = &ptSoftwareDrawCtx->tFontTexture;
+}
+
+void
+pl_cleanup_software_font_texture(plFontAtlas* ptAtlas)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+    memset(&ptSoftwareDrawCtx->tFontTexture, 0, sizeof(plSoftwareTexture));
+    ptAtlas->tTexture = NULL;
+}
+
+void
+pl_new_draw_frame_software(void)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+    memset(&ptSoftwareDrawCtx->tStats, 0, sizeof(plSoftwareStats));
+}
+
+plTextureId
+pl_add_software_texture(const unsigned char* pucData, uint32_t uWidth, uint32_t uHeight, uint32_t uChannels)
+{
+    PL_UI_ASSERT(uChannels == 1u || uChannels == 4u);
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    plSoftwareTexture* ptTexture = malloc(sizeof(plSoftwareTexture));
+    ptTexture->pucData   = pucData;
+    ptTexture->uWidth    = uWidth;
+    ptTexture->uHeight   = uHeight;
+    ptTexture->uChannels = uChannels;
+    plu_sb_push(ptSoftwareDrawCtx->sbtTextures, ptTexture);
+    return ptTexture;
+}
+
+plSoftwareStats
+pl_get_software_stats(void)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+    return ptSoftwareDrawCtx->tStats;
+}
+
+void
+pl_submit_software_drawlist(plDrawList* ptDrawlist, float fWidth, float fHeight, unsigned char* pucFramebuffer)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plSoftwareDrawContext* ptSoftwareDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    // the font texture points straight at the atlas pixels, so glyphs
+    // rasterized on demand are already visible
+    if(ptCtx->fontAtlas)
+        plu_sb_reset(ptCtx->fontAtlas->sbtDirtyRects);
+
+    // merge layers into final commands & single vertex/index buffers
+    pl_compile_drawlist(ptDrawlist);
+
+    if(plu_sb_size(ptDrawlist->sbtVertexBuffer) == 0u)
+        return;
+
+    plSoftwareTarget tTarget = {
+        .pucPixels = pucFramebuffer,
+        .uWidth    = (uint32_t)fWidth,
+        .uHeight   = (uint32_t)fHeight
+    };
+
+    ptSoftwareDrawCtx->tStats.uVertices += plu_sb_size(ptDrawlist->sbtVertexBuffer);
+
+    for(uint32_t i = 0u; i < plu_sb_size(ptDrawlist->sbtDrawCommands); i++)
+    {
+        const plDrawCommand* ptCmd = &ptDrawlist->sbtDrawCommands[i];
+        plRect tClip = ptCmd->tClip;
+
+        if(plu_rect_width(&tClip) == 0)
+        {
+            tClip.tMin.x = 0.0f;
+            tClip.tMin.y = 0.0f;
+            tClip.tMax.x = fWidth;
+            tClip.tMax.y = fHeight;
+        }
+        else
+        {
+            // clamp to viewport
+            if (tClip.tMin.x < 0.0f)    { tClip.tMin.x = 0.0f; }
+            if (tClip.tMin.y < 0.0f)    { tClip.tMin.y = 0.0f; }
+            if (tClip.tMax.x > fWidth)  { tClip.tMax.x = fWidth; }
+            if (tClip.tMax.y > fHeight) { tClip.tMax.y = fHeight; }
+            if (tClip.tMax.x <= tClip.tMin.x || tClip.tMax.y <= tClip.tMin.y)
+                continue;
+        }
+
+        tTarget.iClipMinX = (int)tClip.tMin.x;
+        tTarget.iClipMinY = (int)tClip.tMin.y;
+        tTarget.iClipMaxX = tTarget.iClipMinX + (int)plu_rect_width(&tClip);
+        tTarget.iClipMaxY = tTarget.iClipMinY + (int)plu_rect_height(&tClip);
+
+        const plSoftwareTexture* ptTexture = ptCmd->tTextureId;
+        const uint32_t* puIndices = &ptDrawlist->sbuIndexBuffer[ptCmd->uIndexOffset];
+        ptSoftwareDrawCtx->tStats.uDrawCommands++;
+        ptSoftwareDrawCtx->tStats.uTriangles += ptCmd->uElementCount / 3;
+
+        // indices are absolute into the compiled vertex buffer
+        for(uint32_t k = 0u; k + 2 < ptCmd->uElementCount; k += 3)
+        {
+            pl__rasterize_triangle(ptSoftwareDrawCtx, &tTarget, ptTexture, ptCmd->bSdf,
+                &ptDrawlist->sbtVertexBuffer[puIndices[k]],
+                &ptDrawlist->sbtVertexBuffer[puIndices[k + 1]],
+                &ptDrawlist->sbtVertexBuffer[puIndices[k + 2]]);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api implementation
+//-----------------------------------------------------------------------------
+
+static void
+pl__sample_software_texture(const plSoftwareTexture* ptTexture, float fU, float fV, float* afColorOut)
+{
+    // missing texture samples as opaque white
+    if(ptTexture == NULL || ptTexture->pucData == NULL)
+    {
+        afColorOut[0] = 1.0f; afColorOut[1] = 1.0f; afColorOut[2] = 1.0f; afColorOut[3] = 1.0f;
+        return;
+    }
+
+    // bilinear filter, clamp to edge (matches the gpu backends' font sampler)
+    const int iMaxX = (int)ptTexture->uWidth - 1;
+    const int iMaxY = (int)ptTexture->uHeight - 1;
+    const float fX = fU * (float)ptTexture->uWidth - 0.5f;
+    const float fY = fV * (float)ptTexture->uHeight - 0.5f;
+    const float fFloorX = floorf(fX);
+    const float fFloorY = floorf(fY);
+    const float fTx = fX - fFloorX;
+    const float fTy = fY - fFloorY;
+
+    int iX0 = (int)fFloorX;
+    int iY0 = (int)fFloorY;
+    int iX1 = iX0 + 1;
+    int iY1 = iY0 + 1;
+    iX0 = iX0 < 0 ? 0 : (iX0 > iMaxX ? iMaxX : iX0);
+    iX1 = iX1 < 0 ? 0 : (iX1 > iMaxX ? iMaxX : iX1);
+    iY0 = iY0 < 0 ? 0 : (iY0 > iMaxY ? iMaxY : iY0);
+    iY1 = iY1 < 0 ? 0 : (iY1 > iMaxY ? iMaxY : iY1);
+
+    const float fW00 = (1.0f - fTx) * (1.0f - fTy);
+    const float fW10 = fTx * (1.0f - fTy);
+    const float fW01 = (1.0f - fTx) * fTy;
+    const float fW11 = fTx * fTy;
+    const uint32_t uChannels = ptTexture->uChannels;
+    const unsigned char* pucRow0 = &ptTexture->pucData[(size_t)iY0 * ptTexture->uWidth * uChannels];
+    const unsigned char* pucRow1 = &ptTexture->pucData[(size_t)iY1 * ptTexture->uWidth * uChannels];
+
+    if(uChannels == 1u)
+    {
+        afColorOut[0] = 1.0f; afColorOut[1] = 1.0f; afColorOut[2] = 1.0f;
+        afColorOut[3] = (fW00 * pucRow0[iX0] + fW10 * pucRow0[iX1] + fW01 * pucRow1[iX0] + fW11 * pucRow1[iX1]) / 255.0f;
+        return;
+    }
+
+    for(uint32_t c = 0; c < 4; c++)
+    {
+        afColorOut[c] = (
+            fW00 * pucRow0[iX0 * 4 + c] + fW10 * pucRow0[iX1 * 4 + c] +
+            fW01 * pucRow1[iX0 * 4 + c] + fW11 * pucRow1[iX1 * 4 + c]) / 255.0f;
+    }
+}
+
+static inline float
+pl__edge_function(float fAx, float fAy, float fBx, float fBy, float fPx, float fPy)
+{
+    return (fBx - fAx) * (fPy - fAy) - (fBy - fAy) * (fPx - fAx);
+}
+
+static inline bool
+pl__edge_owns_boundary(float fAx, float fAy, float fBx, float fBy)
+{
+    // a shared edge is walked in opposite directions by its two triangles,
+    // so exactly one of them claims pixels lying exactly on it
+    const float fDy = fBy - fAy;
+    return fDy > 0.0f || (fDy == 0.0f && (fBx - fAx) < 0.0f);
+}
+
+static inline float
+pl__smoothstep(float fEdge0, float fEdge1, float fX)
+{
+    float fT = (fX - fEdge0) / (fEdge1 - fEdge0);
+    fT = fT < 0.0f ? 0.0f : (fT > 1.0f ? 1.0f : fT);
+    return fT * fT * (3.0f - 2.0f * fT);
+}
+
+static void
+pl__rasterize_triangle(plSoftwareDrawContext* ptCtx, plSoftwareTarget* ptTarget, const plSoftwareTexture* ptTexture, bool bSdf, const plDrawVertex* ptV0, const plDrawVertex* ptV1, const plDrawVertex* ptV2)
+{
+    float fArea = pl__edge_function(ptV0->afPos[0], ptV0->afPos[1], ptV1->afPos[0], ptV1->afPos[1], ptV2->afPos[0], ptV2->afPos[1]);
+    if(fArea == 0.0f)
+        return;
+
+    // normalize winding so all edge functions are positive inside
+    if(fArea < 0.0f)
+    {
+        const plDrawVertex* ptTemp = ptV1;
+        ptV1 = ptV2;
+        ptV2 = ptTemp;
+        fArea = -fArea;
+    }
+
+    const float fX0 = ptV0->afPos[0], fY0 = ptV0->afPos[1];
+    const float fX1 = ptV1->afPos[0], fY1 = ptV1->afPos[1];
+    const float fX2 = ptV2->afPos[0], fY2 = ptV2->afPos[1];
+
+    // bounding box clipped against scissor
+    int iMinX = (int)floorf(plu_minf(fX0, plu_minf(fX1, fX2)));
+    int iMinY = (int)floorf(plu_minf(fY0, plu_minf(fY1, fY2)));
+    int iMaxX = (int)ceilf(plu_maxf(fX0, plu_maxf(fX1, fX2)));
+    int iMaxY = (int)ceilf(plu_maxf(fY0, plu_maxf(fY1, fY2)));
+    if(iMinX < ptTarget->iClipMinX) iMinX = ptTarget->iClipMinX;
+    if(iMinY < ptTarget->iClipMinY) iMinY = ptTarget->iClipMinY;
+    if(iMaxX > ptTarget->iClipMaxX) iMaxX = ptTarget->iClipMaxX;
+    if(iMaxY > ptTarget->iClipMaxY) iMaxY = ptTarget->iClipMaxY;
+    if(iMinX >= iMaxX || iMinY >= iMaxY)
+        return;
+
+    const bool bOwn0 = pl__edge_owns_boundary(fX1, fY1, fX2, fY2);
+    const bool bOwn1 = pl__edge_owns_boundary(fX2, fY2, fX0, fY0);
+    const bool bOwn2 = pl__edge_owns_boundary(fX0, fY0, fX1, fY1);
+
+    // per pixel edge function steps
+    const float fStepX0 = -(fY2 - fY1), fStepY0 = fX2 - fX1;
+    const float fStepX1 = -(fY0 - fY2), fStepY1 = fX0 - fX2;
+    const float fStepX2 = -(fY1 - fY0), fStepY2 = fX1 - fX0;
+    const float fInvArea = 1.0f / fArea;
+
+    // unpack vertex colors
+    float aafColor[3][4];
+    const plDrawVertex* aptVerts[3] = {ptV0, ptV1, ptV2};
+    for(uint32_t v = 0; v < 3; v++)
+    {
+        const uint32_t uColor = aptVerts[v]->uColor;
+        aafColor[v][0] = (float)((uColor >>  0) & 0xFF) / 255.0f;
+        aafColor[v][1] = (float)((uColor >>  8) & 0xFF) / 255.0f;
+        aafColor[v][2] = (float)((uColor >> 16) & 0xFF) / 255.0f;
+        aafColor[v][3] = (float)((uColor >> 24) & 0xFF) / 255.0f;
+    }
+
+    // uv derivatives are constant across an affine triangle (used for sdf fwidth)
+    const float fDuDx = (ptV0->afUv[0] * fStepX0 + ptV1->afUv[0] * fStepX1 + ptV2->afUv[0] * fStepX2) * fInvArea;
+    const float fDvDx = (ptV0->afUv[1] * fStepX0 + ptV1->afUv[1] * fStepX1 + ptV2->afUv[1] * fStepX2) * fInvArea;
+    const float fDuDy = (ptV0->afUv[0] * fStepY0 + ptV1->afUv[0] * fStepY1 + ptV2->afUv[0] * fStepY2) * fInvArea;
+    const float fDvDy = (ptV0->afUv[1] * fStepY0 + ptV1->afUv[1] * fStepY1 + ptV2->afUv[1] * fStepY2) * fInvArea;
+
+    // solid geometry samples the white pixel everywhere, so sample once
+    const bool bConstantUv = !bSdf &&
+        ptV0->afUv[0] == ptV1->afUv[0] && ptV0->afUv[0] == ptV2->afUv[0] &&
+        ptV0->afUv[1] == ptV1->afUv[1] && ptV0->afUv[1] == ptV2->afUv[1];
+    const bool bConstantColor = ptV0->uColor == ptV1->uColor && ptV0->uColor == ptV2->uColor;
+    float afConstantTexel[4] = {0};
+    if(bConstantUv)
+        pl__sample_software_texture(ptTexture, ptV0->afUv[0], ptV0->afUv[1], afConstantTexel);
+
+    const float fStartX = (float)iMinX + 0.5f;
+    const float fStartY = (float)iMinY + 0.5f;
+    float fRowW0 = pl__edge_function(fX1, fY1, fX2, fY2, fStartX, fStartY);
+    float fRowW1 = pl__edge_function(fX2, fY2, fX0, fY0, fStartX, fStartY);
+    float fRowW2 = pl__edge_function(fX0, fY0, fX1, fY1, fStartX, fStartY);
+
+    uint64_t ulPixelsShaded = 0;
+    for(int iY = iMinY; iY < iMaxY; iY++)
+    {
+        float fW0 = fRowW0;
+        float fW1 = fRowW1;
+        float fW2 = fRowW2;
+        unsigned char* pucDst = &ptTarget->pucPixels[((size_t)iY * ptTarget->uWidth + (size_t)iMinX) * 4];
+
+        for(int iX = iMinX; iX < iMaxX; iX++, pucDst += 4, fW0 += fStepX0, fW1 += fStepX1, fW2 += fStepX2)
+        {
+            if(fW0 < 0.0f || fW1 < 0.0f || fW2 < 0.0f)
+                continue;
+            if((fW0 == 0.0f && !bOwn0) || (fW1 == 0.0f && !bOwn1) || (fW2 == 0.0f && !bOwn2))
+                continue;
+
+            const float fB0 = fW0 * fInvArea;
+            const float fB1 = fW1 * fInvArea;
+            const float fB2 = fW2 * fInvArea;
+
+            float afSrc[4];
+            if(bConstantColor)
+            {
+                memcpy(afSrc, aafColor[0], sizeof(afSrc));
+            }
+            else
+            {
+                for(uint32_t c = 0; c < 4; c++)
+                    afSrc[c] = fB0 * aafColor[0][c] + fB1 * aafColor[1][c] + fB2 * aafColor[2][c];
+            }
+
+            if(bConstantUv)
+            {
+                for(uint32_t c = 0; c < 4; c++)
+                    afSrc[c] *= afConstantTexel[c];
+            }
+            else
+            {
+                const float fU = fB0 * ptV0->afUv[0] + fB1 * ptV1->afUv[0] + fB2 * ptV2->afUv[0];
+                const float fV = fB0 * ptV0->afUv[1] + fB1 * ptV1->afUv[1] + fB2 * ptV2->afUv[1];
+                float afTexel[4];
+                pl__sample_software_texture(ptTexture, fU, fV, afTexel);
+
+                if(bSdf)
+                {
+                    // same as the gpu sdf shaders: smoothstep around the on-edge value
+                    float afTexelDx[4];
+                    float afTexelDy[4];
+                    pl__sample_software_texture(ptTexture, fU + fDuDx, fV + fDvDx, afTexelDx);
+                    pl__sample_software_texture(ptTexture, fU + fDuDy, fV + fDvDy, afTexelDy);
+                    const float fDistance = afTexel[3];
+                    const float fSmoothWidth = fabsf(afTexelDx[3] - fDistance) + fabsf(afTexelDy[3] - fDistance);
+                    const float fAlpha = fSmoothWidth > 0.0f ? pl__smoothstep(0.5f - fSmoothWidth, 0.5f + fSmoothWidth, fDistance) : (fDistance >= 0.5f ? 1.0f : 0.0f);
+                    afSrc[0] *= afTexel[0];
+                    afSrc[1] *= afTexel[1];
+                    afSrc[2] *= afTexel[2];
+                    afSrc[3] *= fAlpha;
+                }
+                else
+                {
+                    for(uint32_t c = 0; c < 4; c++)
+                        afSrc[c] *= afTexel[c];
+                }
+            }
+
+            if(afSrc[3] <= 0.0f)
+                continue;
+
+            // src alpha / one minus src alpha blending
+            const float fInvSrcAlpha = 1.0f - afSrc[3];
+            for(uint32_t c = 0; c < 3; c++)
+                pucDst[c] = (unsigned char)(afSrc[c] * afSrc[3] * 255.0f + (float)pucDst[c] * fInvSrcAlpha + 0.5f);
+            pucDst[3] = (unsigned char)(afSrc[3] * 255.0f + (float)pucDst[3] * fInvSrcAlpha + 0.5f);
+            ulPixelsShaded++;
+        }
+
+        fRowW0 += fStepY0;
+        fRowW1 += fStepY1;
+        fRowW2 += fStepY2;
+    }
+    ptCtx->tStats.ulPixelsShaded += ulPixelsShaded;
+}
@@ -0,0 +1,69 @@
+/*
+   pl_ui_software.h
+     * headless cpu rasterizer (no gpu required)
+     * writes into a caller owned, tightly packed RGBA8 framebuffer
+*/
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] structs
+// [SECTION] public api
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_UI_SOFTWARE_H
+#define PL_UI_SOFTWARE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plSoftwareTexture
+{
+    const unsigned char* pucData;
+    uint32_t             uWidth;
+    uint32_t             uHeight;
+    uint32_t             uChannels; // 1 (alpha8, rgb is white) or 4 (rgba32)
+} plSoftwareTexture;
+
+typedef struct _plSoftwareStats
+{
+    uint32_t uDrawCommands;     // draw commands processed during last frame
+    uint32_t uTriangles;        // triangles submitted during last frame
+    uint32_t uVertices;         // vertices consumed during last frame
+    uint64_t ulPixelsShaded;    // fragments blended during last frame
+} plSoftwareStats;
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api
+//-----------------------------------------------------------------------------
+
+void            pl_initialize_software          (void);
+void            pl_cleanup_software             (void);
+void            pl_create_software_font_texture (plFontAtlas* ptAtlas);
+void            pl_cleanup_software_font_texture(plFontAtlas* ptAtlas);
+void            pl_new_draw_frame_software      (void);
+void            pl_submit_software_drawlist     (plDrawList* ptDrawlist, float fWidth, float fHeight, unsigned char* pucFramebuffer);
+plTextureId     pl_add_software_texture         (const unsigned char* pucData, uint32_t uWidth, uint32_t uHeight, uint32_t uChannels);
+plSoftwareStats pl_get_software_stats           (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PL_UI_SOFTWARE_H
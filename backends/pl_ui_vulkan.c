@@ -241,6 +241,13 @@ typedef struct _plVulkanBufferInfo
     unsigned char* ucIndexBufferMap;
     uint32_t       uIndexByteSize;
     uint32_t       uIndexBufferOffset;
+
+    // staging buffer (font atlas uploads)
+    VkBuffer       tStagingBuffer;
+    VkDeviceMemory tStagingMemory;
+    unsigned char* ucStagingBufferMap;
+    uint32_t       uStagingByteSize;
+    uint32_t       uStagingBufferOffset;
 } plVulkanBufferInfo;
 
 typedef struct _plVulkanDrawContext
@@ -270,14 +277,11 @@ typedef struct _plVulkanDrawContext
     plTextureReturn*                 sbReturnedTexturesTemp;
     uint32_t                         uTextureDeletionQueueSize;
 
-    // vertex & index buffer
+    // vertex, index & staging buffers (per frame in flight)
     plVulkanBufferInfo*              sbtBufferInfo;
 
-    // staging buffer
-    size_t                            szStageByteSize;
-    VkBuffer                          tStagingBuffer;
-    VkDeviceMemory                    tStagingMemory;
-    void*                             pStageMapping; // persistent mapping for staging buffer
+    // font atlas upload regions (reused every frame)
+    VkBufferImageCopy*               sbtUploadRegions;
 
     // drawlist pipeline caching
     VkPipelineLayout                  tPipelineLayout;
@@ -297,8 +301,10 @@ typedef struct _plVulkanDrawContext
 //-----------------------------------------------------------------------------
 
 static uint32_t               pl__find_memory_type            (VkPhysicalDeviceMemoryProperties tMemProps, uint32_t typeFilter, VkMemoryPropertyFlags properties);
+static void                   pl__record_vulkan_font_upload   (VkCommandBuffer tCmdBuf, plFontAtlas* ptAtlas, const plFontAtlasRect* atRects, uint32_t uRectCount, plVulkanBufferInfo* ptBufferInfo, VkImageLayout tOldLayout);
 static void                   pl__grow_vulkan_vertex_buffer   (uint32_t uVtxBufSzNeeded, plVulkanBufferInfo* ptBufferInfo);
 static void                   pl__grow_vulkan_index_buffer    (uint32_t uIdxBufSzNeeded, plVulkanBufferInfo* ptBufferInfo);
+static void                   pl__grow_vulkan_staging_buffer  (uint32_t uStageBufSzNeeded, plVulkanBufferInfo* ptBufferInfo);
 static plVulkanPipelineEntry* pl__get_pipelines               (plVulkanDrawContext* ptCtx, VkRenderPass tRenderPass, VkSampleCountFlagBits tMSAASampleCount);
 
 //-----------------------------------------------------------------------------
@@ -508,9 +514,25 @@ pl_new_draw_frame_vulkan(void)
     {
         ptVulkanDrawContext->sbtBufferInfo[i].uVertexBufferOffset = 0;
         ptVulkanDrawContext->sbtBufferInfo[i].uIndexBufferOffset = 0;
+        ptVulkanDrawContext->sbtBufferInfo[i].uStagingBufferOffset = 0;
     }
 }
 
+void
+pl_record_vulkan_font_updates(VkCommandBuffer tCmdBuf, uint32_t uFrameIndex)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plVulkanDrawContext* ptVulkanDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    // glyphs rasterized on demand by dynamic fonts
+    plFontAtlas* ptAtlas = ptCtx->fontAtlas;
+    if(ptAtlas == NULL || plu_sb_size(ptAtlas->sbtDirtyRects) == 0)
+        return;
+
+    pl__record_vulkan_font_upload(tCmdBuf, ptAtlas, ptAtlas->sbtDirtyRects, plu_sb_size(ptAtlas->sbtDirtyRects), &ptVulkanDrawCtx->sbtBufferInfo[uFrameIndex], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    plu_sb_reset(ptAtlas->sbtDirtyRects);
+}
+
 void
 pl_cleanup_vulkan_font_texture(plFontAtlas* ptAtlas)
 {
@@ -537,6 +559,9 @@ pl_submit_vulkan_drawlist(plDrawList* ptDrawlist, float fWidth, float fHeight, V
 void
 pl_submit_vulkan_drawlist_ex(plDrawList* ptDrawlist, float fWidth, float fHeight, VkCommandBuffer tCmdBuf, uint32_t uFrameIndex, VkRenderPass tRenderPass, VkSampleCountFlagBits tMSAASampleCount)
 {
+    // merge layers into final commands & single vertex/index buffers
+    pl_compile_drawlist(ptDrawlist);
+
     if(plu_sb_size(ptDrawlist->sbtVertexBuffer) == 0u)
         return;
 
@@ -576,56 +601,9 @@ pl_submit_vulkan_drawlist_ex(plDrawList* ptDrawlist, float fWidth, float fHeight
     if(uIdxBufSzNeeded >= uAvailableIndexBufferSpace)
         pl__grow_vulkan_index_buffer(uIdxBufSzNeeded * 2, tBufferInfo);
 
-    unsigned char* pucMappedIndexBufferLocation = tBufferInfo->ucIndexBufferMap;
-    unsigned char* pucDestination = &pucMappedIndexBufferLocation[tBufferInfo->uIndexBufferOffset];
-    
     // index GPU data transfer
-    uint32_t uTempIndexBufferOffset = 0u;
-    uint32_t globalIdxBufferIndexOffset = 0u;
-
-    for(uint32_t i = 0u; i < plu_sb_size(ptDrawlist->sbtSubmittedLayers); i++)
-    {
-        plDrawCommand* ptLastCommand = NULL;
-        plDrawLayer* ptLayer = ptDrawlist->sbtSubmittedLayers[i];
-
-        memcpy(&pucDestination[uTempIndexBufferOffset], ptLayer->sbuIndexBuffer, sizeof(uint32_t) * plu_sb_size(ptLayer->sbuIndexBuffer));
-
-        uTempIndexBufferOffset += plu_sb_size(ptLayer->sbuIndexBuffer)*sizeof(uint32_t);
-
-        // attempt to merge commands
-        for(uint32_t j = 0u; j < plu_sb_size(ptLayer->sbtCommandBuffer); j++)
-        {
-            plDrawCommand* ptLayerCommand = &ptLayer->sbtCommandBuffer[j];
-            bool bCreateNewCommand = true;
-
-            if(ptLastCommand)
-            {
-                // check for same texture (allows merging draw calls)
-                if(ptLastCommand->tTextureId == ptLayerCommand->tTextureId && ptLastCommand->bSdf == ptLayerCommand->bSdf)
-                {
-                    ptLastCommand->uElementCount += ptLayerCommand->uElementCount;
-                    bCreateNewCommand = false;
-                }
-
-                // check for same clipping (allows merging draw calls)
-                if(ptLayerCommand->tClip.tMax.x != ptLastCommand->tClip.tMax.x || ptLayerCommand->tClip.tMax.y != ptLastCommand->tClip.tMax.y ||
-                    ptLayerCommand->tClip.tMin.x != ptLastCommand->tClip.tMin.x || ptLayerCommand->tClip.tMin.y != ptLastCommand->tClip.tMin.y)
-                {
-                    bCreateNewCommand = true;
-                }
-                
-            }
-
-            if(bCreateNewCommand)
-            {
-                ptLayerCommand->uIndexOffset = globalIdxBufferIndexOffset + ptLayerCommand->uIndexOffset;
-                plu_sb_push(ptDrawlist->sbtDrawCommands, *ptLayerCommand);       
-                ptLastCommand = ptLayerCommand;
-            }
-            
-        }    
-        globalIdxBufferIndexOffset += plu_sb_size(ptLayer->sbuIndexBuffer);    
-    }
+    unsigned char* pucMappedIndexBufferLocation = tBufferInfo->ucIndexBufferMap;
+    memcpy(&pucMappedIndexBufferLocation[tBufferInfo->uIndexBufferOffset], ptDrawlist->sbuIndexBuffer, uIdxBufSzNeeded);
 
     const VkMappedMemoryRange aRange[2] = {
         {
@@ -725,8 +703,6 @@ pl_cleanup_vulkan(void)
     vkDestroyShaderModule(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tVtxShdrStgInfo.module, NULL);
     vkDestroyShaderModule(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tPxlShdrStgInfo.module, NULL);
     vkDestroyShaderModule(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tSdfShdrStgInfo.module, NULL);
-    vkDestroyBuffer(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingBuffer, NULL);
-    vkFreeMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingMemory, NULL);
     vkDestroyDescriptorSetLayout(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tDescriptorSetLayout, NULL);
     vkDestroySampler(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tFontSampler, NULL);
     vkDestroyPipelineLayout(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tPipelineLayout, NULL);
@@ -737,6 +713,8 @@ pl_cleanup_vulkan(void)
         vkFreeMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->sbtBufferInfo[i].tVertexMemory, NULL);
         vkDestroyBuffer(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->sbtBufferInfo[i].tIndexBuffer, NULL);
         vkFreeMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->sbtBufferInfo[i].tIndexMemory, NULL);
+        vkDestroyBuffer(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->sbtBufferInfo[i].tStagingBuffer, NULL);
+        vkFreeMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->sbtBufferInfo[i].tStagingMemory, NULL);
     }
 
     for(uint32_t i = 0u; i < plu_sb_size(ptVulkanDrawCtx->sbtPipelines); i++)
@@ -770,6 +748,7 @@ pl_cleanup_vulkan(void)
     plu_sb_free(ptVulkanDrawCtx->sbReturnedBuffers);
     plu_sb_free(ptVulkanDrawCtx->sbReturnedBuffersTemp);
     plu_sb_free(ptVulkanDrawCtx->sbtBufferInfo);
+    plu_sb_free(ptVulkanDrawCtx->sbtUploadRegions);
     plu_sb_free(ptVulkanDrawCtx->sbtPipelines);
     plu_sb_free(ptVulkanDrawCtx->sbReturnedTextures);
 
@@ -829,7 +808,7 @@ pl_create_vulkan_font_texture(plFontAtlas* ptAtlas)
         .extent.depth  = 1u,
         .mipLevels     = 1u,
         .arrayLayers   = 1u,
-        .format        = VK_FORMAT_R8G8B8A8_UNORM,
+        .format        = ptAtlas->bAlpha8Only ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8G8B8A8_UNORM,
         .tiling        = VK_IMAGE_TILING_OPTIMAL,
         .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
         .usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
@@ -850,57 +829,8 @@ pl_create_vulkan_font_texture(plFontAtlas* ptAtlas)
     PL_VULKAN(vkAllocateMemory(ptVulkanDrawCtx->tDevice, &tFinalAllocInfo, NULL, &ptVulkanDrawCtx->tFontTextureMemory));
     PL_VULKAN(vkBindImageMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tFontTextureImage, ptVulkanDrawCtx->tFontTextureMemory, 0));
 
-    // upload data
-    uint32_t uDataSize = ptAtlas->auAtlasSize[0] * ptAtlas->auAtlasSize[1] * 4u;
-    if(uDataSize > ptVulkanDrawCtx->szStageByteSize)
-    {
-        if(ptVulkanDrawCtx->tStagingMemory)
-        {
-            vkUnmapMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingMemory);
-            vkDestroyBuffer(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingBuffer, NULL);
-            vkFreeMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingMemory, NULL);
-        }
-
-        // double staging buffer size
-        const VkBufferCreateInfo tStagingBufferInfo = {
-            .sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size        = uDataSize * 2,
-            .usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
-        };
-        PL_VULKAN(vkCreateBuffer(ptVulkanDrawCtx->tDevice, &tStagingBufferInfo, NULL, &ptVulkanDrawCtx->tStagingBuffer));
-
-        VkMemoryRequirements tStagingMemoryRequirements = {0};
-        vkGetBufferMemoryRequirements(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingBuffer, &tStagingMemoryRequirements);
-        ptVulkanDrawCtx->szStageByteSize = tStagingMemoryRequirements.size;
-
-        const VkMemoryAllocateInfo tStagingAllocInfo = {
-            .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize  = tStagingMemoryRequirements.size,
-            .memoryTypeIndex = pl__find_memory_type(ptVulkanDrawCtx->tMemProps, tStagingMemoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
-        };
-
-        PL_VULKAN(vkAllocateMemory(ptVulkanDrawCtx->tDevice, &tStagingAllocInfo, NULL, &ptVulkanDrawCtx->tStagingMemory));
-        PL_VULKAN(vkBindBufferMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingBuffer, ptVulkanDrawCtx->tStagingMemory, 0));   
-        PL_VULKAN(vkMapMemory(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tStagingMemory, 0, VK_WHOLE_SIZE, 0, &ptVulkanDrawCtx->pStageMapping));
-    }
-    memcpy(ptVulkanDrawCtx->pStageMapping, ptAtlas->pucPixelsAsRGBA32, uDataSize);
-
-    const VkMappedMemoryRange tRange = {
-        .sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-        .memory = ptVulkanDrawCtx->tStagingMemory,
-        .size   = VK_WHOLE_SIZE
-    };
-    PL_VULKAN(vkFlushMappedMemoryRanges(ptVulkanDrawCtx->tDevice, 1, &tRange));
-
-    const VkImageSubresourceRange tSubresourceRange = {
-        .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-        .baseMipLevel   = 0u,
-        .levelCount     = 1u,
-        .baseArrayLayer = 0u,
-        .layerCount     = 1u
-    };
-
+    // upload data (one time submission at creation, later updates are recorded
+    // into the frame's command buffer by "pl_record_vulkan_font_updates()")
     const VkCommandBufferAllocateInfo tAllocInfo = {
         .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
         .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
@@ -916,68 +846,33 @@ pl_create_vulkan_font_texture(plFontAtlas* ptAtlas)
     };
     PL_VULKAN(vkBeginCommandBuffer(tCommandBuffer, &tBeginInfo));
 
-    VkImageMemoryBarrier tBarrier1 = {
-        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-        .oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED,
-        .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .image               = ptVulkanDrawCtx->tFontTextureImage,
-        .subresourceRange    = tSubresourceRange,
-        .srcAccessMask       = 0,
-        .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT
-    };
-    vkCmdPipelineBarrier(tCommandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, NULL, 0, NULL, 1, &tBarrier1);
-
-    // copy buffer to image
-    const VkBufferImageCopy tRegion = {
-        .bufferOffset      = 0u,
-        .bufferRowLength   = 0u,
-        .bufferImageHeight = 0u,
-        .imageSubresource  = {
-            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-            .mipLevel       = 0u,
-            .baseArrayLayer = 0u,
-            .layerCount     = 1u
-        },
-        .imageOffset = {0},
-        .imageExtent = {
-            .width  = ptAtlas->auAtlasSize[0], 
-            .height = ptAtlas->auAtlasSize[1],
-            .depth  = 1
-        }
-    };
-    vkCmdCopyBufferToImage(tCommandBuffer, ptVulkanDrawCtx->tStagingBuffer, ptVulkanDrawCtx->tFontTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &tRegion);     
-
-    // transition image layout for shader usage
-    VkImageMemoryBarrier tBarrier2 = {
-        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-        .oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        .newLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .image               = ptVulkanDrawCtx->tFontTextureImage,
-        .subresourceRange    = tSubresourceRange,
-        .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .dstAccessMask       = VK_ACCESS_SHADER_READ_BIT
-    };
-    vkCmdPipelineBarrier(tCommandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, NULL, 0, NULL, 1, &tBarrier2);
+    const plFontAtlasRect tFullRect = {0u, 0u, ptAtlas->auAtlasSize[0], ptAtlas->auAtlasSize[1]};
+    pl__record_vulkan_font_upload(tCommandBuffer, ptAtlas, &tFullRect, 1u, &ptVulkanDrawCtx->sbtBufferInfo[0], VK_IMAGE_LAYOUT_UNDEFINED);
+    PL_VULKAN(vkEndCommandBuffer(tCommandBuffer));
 
     const VkSubmitInfo tSubmitInfo = {
         .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .commandBufferCount = 1u,
         .pCommandBuffers    = &tCommandBuffer
     };
-    PL_VULKAN(vkEndCommandBuffer(tCommandBuffer));
-    vkQueueSubmit(ptVulkanDrawCtx->tGraphicsQueue, 1, &tSubmitInfo, VK_NULL_HANDLE);
-    PL_VULKAN(vkDeviceWaitIdle(ptVulkanDrawCtx->tDevice));
+    PL_VULKAN(vkQueueSubmit(ptVulkanDrawCtx->tGraphicsQueue, 1, &tSubmitInfo, VK_NULL_HANDLE));
+    PL_VULKAN(vkQueueWaitIdle(ptVulkanDrawCtx->tGraphicsQueue));
     vkFreeCommandBuffers(ptVulkanDrawCtx->tDevice, ptVulkanDrawCtx->tCmdPool, 1, &tCommandBuffer);
+    ptVulkanDrawCtx->sbtBufferInfo[0].uStagingBufferOffset = 0;
 
+    // alpha8 only: sampled as (1, 1, 1, R) like the expanded RGBA atlas, the
+    // regular shader multiplies by it and the sdf shader reads distance from .a
     const VkImageViewCreateInfo tViewInfo = {
         .sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .image            = ptVulkanDrawCtx->tFontTextureImage,
         .viewType         = VK_IMAGE_VIEW_TYPE_2D,
-        .format           = VK_FORMAT_R8G8B8A8_UNORM,
+        .format           = tImageInfo.format,
+        .components       = {
+            .r = ptAtlas->bAlpha8Only ? VK_COMPONENT_SWIZZLE_ONE : VK_COMPONENT_SWIZZLE_IDENTITY,
+            .g = ptAtlas->bAlpha8Only ? VK_COMPONENT_SWIZZLE_ONE : VK_COMPONENT_SWIZZLE_IDENTITY,
+            .b = ptAtlas->bAlpha8Only ? VK_COMPONENT_SWIZZLE_ONE : VK_COMPONENT_SWIZZLE_IDENTITY,
+            .a = ptAtlas->bAlpha8Only ? VK_COMPONENT_SWIZZLE_R   : VK_COMPONENT_SWIZZLE_IDENTITY
+        },
         .subresourceRange = {
             .baseMipLevel   = 0u,
             .levelCount     = tImageInfo.mipLevels,
@@ -1006,6 +901,105 @@ pl__find_memory_type(VkPhysicalDeviceMemoryProperties tMemProps, uint32_t uTypeF
     return 0;
 }
 
+static void
+pl__record_vulkan_font_upload(VkCommandBuffer tCmdBuf, plFontAtlas* ptAtlas, const plFontAtlasRect* atRects, uint32_t uRectCount, plVulkanBufferInfo* ptBufferInfo, VkImageLayout tOldLayout)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plVulkanDrawContext* ptVulkanDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    // alpha8 only atlases upload the single channel copy
+    const uint32_t uBytesPerPixel = ptAtlas->bAlpha8Only ? 1u : 4u;
+    const unsigned char* pucPixels = ptAtlas->bAlpha8Only ? ptAtlas->pucPixelsAsAlpha8 : ptAtlas->pucPixelsAsRGBA32;
+
+    // rects are packed one after another (4 byte aligned) in this frame's staging buffer
+    uint32_t uStageBufSzNeeded = 0u;
+    for(uint32_t i = 0; i < uRectCount; i++)
+        uStageBufSzNeeded += (atRects[i].uWidth * atRects[i].uHeight * uBytesPerPixel + 3u) & ~3u;
+
+    // grow buffer if not enough room (the old one is still in use by the gpu)
+    if(uStageBufSzNeeded > ptBufferInfo->uStagingByteSize - ptBufferInfo->uStagingBufferOffset)
+        pl__grow_vulkan_staging_buffer(uStageBufSzNeeded * 2, ptBufferInfo);
+
+    plu_sb_reset(ptVulkanDrawCtx->sbtUploadRegions);
+    uint32_t uBufferOffset = ptBufferInfo->uStagingBufferOffset;
+    for(uint32_t i = 0; i < uRectCount; i++)
+    {
+        const plFontAtlasRect* ptRect = &atRects[i];
+        const uint32_t uRowSize = ptRect->uWidth * uBytesPerPixel;
+        unsigned char* pucStage = &ptBufferInfo->ucStagingBufferMap[uBufferOffset];
+        for(uint32_t y = 0; y < ptRect->uHeight; y++)
+        {
+            memcpy(pucStage, &pucPixels[((ptRect->uY + y) * ptAtlas->auAtlasSize[0] + ptRect->uX) * uBytesPerPixel], uRowSize);
+            pucStage += uRowSize;
+        }
+
+        const VkBufferImageCopy tRegion = {
+            .bufferOffset      = uBufferOffset,
+            .bufferRowLength   = 0u,
+            .bufferImageHeight = 0u,
+            .imageSubresource  = {
+                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel       = 0u,
+                .baseArrayLayer = 0u,
+                .layerCount     = 1u
+            },
+            .imageOffset = {
+                .x = (int32_t)ptRect->uX,
+                .y = (int32_t)ptRect->uY,
+                .z = 0
+            },
+            .imageExtent = {
+                .width  = ptRect->uWidth,
+                .height = ptRect->uHeight,
+                .depth  = 1
+            }
+        };
+        plu_sb_push(ptVulkanDrawCtx->sbtUploadRegions, tRegion);
+        uBufferOffset += (uRowSize * ptRect->uHeight + 3u) & ~3u;
+    }
+    ptBufferInfo->uStagingBufferOffset = uBufferOffset;
+
+    const VkImageSubresourceRange tSubresourceRange = {
+        .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+        .baseMipLevel   = 0u,
+        .levelCount     = 1u,
+        .baseArrayLayer = 0u,
+        .layerCount     = 1u
+    };
+
+    // wait for earlier frames to stop sampling the atlas
+    const VkImageMemoryBarrier tBarrier1 = {
+        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .oldLayout           = tOldLayout,
+        .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image               = ptVulkanDrawCtx->tFontTextureImage,
+        .subresourceRange    = tSubresourceRange,
+        .srcAccessMask       = tOldLayout == VK_IMAGE_LAYOUT_UNDEFINED ? 0 : VK_ACCESS_SHADER_READ_BIT,
+        .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT
+    };
+    const VkPipelineStageFlags tSrcStage = tOldLayout == VK_IMAGE_LAYOUT_UNDEFINED ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    vkCmdPipelineBarrier(tCmdBuf, tSrcStage, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, 1, &tBarrier1);
+
+    // copy buffer to image
+    vkCmdCopyBufferToImage(tCmdBuf, ptBufferInfo->tStagingBuffer, ptVulkanDrawCtx->tFontTextureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, uRectCount, ptVulkanDrawCtx->sbtUploadRegions);
+
+    // transition image layout for shader usage
+    const VkImageMemoryBarrier tBarrier2 = {
+        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .newLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image               = ptVulkanDrawCtx->tFontTextureImage,
+        .subresourceRange    = tSubresourceRange,
+        .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask       = VK_ACCESS_SHADER_READ_BIT
+    };
+    vkCmdPipelineBarrier(tCmdBuf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, &tBarrier2);
+}
+
 static void
 pl__grow_vulkan_vertex_buffer(uint32_t uVtxBufSzNeeded, plVulkanBufferInfo* ptBufferInfo)
 {
@@ -1103,6 +1097,54 @@ pl__grow_vulkan_index_buffer(uint32_t uIdxBufSzNeeded, plVulkanBufferInfo* ptBuf
     ptBufferInfo->uIndexBufferOffset = 0;
 }
 
+static void
+pl__grow_vulkan_staging_buffer(uint32_t uStageBufSzNeeded, plVulkanBufferInfo* ptBufferInfo)
+{
+    plUiContext* ptCtx = pl_get_context();
+    plVulkanDrawContext* ptVulkanDrawCtx = ptCtx->tIO.pBackendRendererData;
+
+    // buffer currently exists & mapped, submit for cleanup
+    if(ptBufferInfo->ucStagingBufferMap)
+    {
+        const plBufferReturn tReturnBuffer = {
+            .tBuffer       = ptBufferInfo->tStagingBuffer,
+            .tDeviceMemory = ptBufferInfo->tStagingMemory,
+            .slFreedFrame  = (int64_t)(ptCtx->frameCount + ptVulkanDrawCtx->uFramesInFlight * 2)
+        };
+        plu_sb_push(ptVulkanDrawCtx->sbReturnedBuffers, tReturnBuffer);
+        ptVulkanDrawCtx->uBufferDeletionQueueSize++;
+        vkUnmapMemory(ptVulkanDrawCtx->tDevice, ptBufferInfo->tStagingMemory);
+    }
+
+    // create new buffer
+    const VkBufferCreateInfo tBufferCreateInfo = {
+        .sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size        = uStageBufSzNeeded,
+        .usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+    PL_VULKAN(vkCreateBuffer(ptVulkanDrawCtx->tDevice, &tBufferCreateInfo, NULL, &ptBufferInfo->tStagingBuffer));
+
+    // check memory requirements
+    VkMemoryRequirements tMemReqs = {0};
+    vkGetBufferMemoryRequirements(ptVulkanDrawCtx->tDevice, ptBufferInfo->tStagingBuffer, &tMemReqs);
+
+    // allocate memory & bind buffer
+    const VkMemoryAllocateInfo tAllocInfo = {
+        .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize  = tMemReqs.size,
+        .memoryTypeIndex = pl__find_memory_type(ptVulkanDrawCtx->tMemProps, tMemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    };
+    ptBufferInfo->uStagingByteSize = (uint32_t)tMemReqs.size;
+    PL_VULKAN(vkAllocateMemory(ptVulkanDrawCtx->tDevice, &tAllocInfo, NULL, &ptBufferInfo->tStagingMemory));
+    PL_VULKAN(vkBindBufferMemory(ptVulkanDrawCtx->tDevice, ptBufferInfo->tStagingBuffer, ptBufferInfo->tStagingMemory, 0));
+
+    // map memory persistently
+    PL_VULKAN(vkMapMemory(ptVulkanDrawCtx->tDevice, ptBufferInfo->tStagingMemory, 0, tMemReqs.size, 0, (void**)&ptBufferInfo->ucStagingBufferMap));
+
+    ptBufferInfo->uStagingBufferOffset = 0;
+}
+
 static plVulkanPipelineEntry*
 pl__get_pipelines(plVulkanDrawContext* ptCtx, VkRenderPass tRenderPass, VkSampleCountFlagBits tMSAASampleCount)
 {
@@ -0,0 +1,47 @@
+/*
+   default font atlas generator (headless)
+     * builds an atlas holding only the default font & writes it out with
+       pl_save_font_atlas_source() as "gauPlBakedDefaultAtlas"
+     * compile pl_ui_draw.c with PL_UI_BAKED_DEFAULT_ATLAS="\"pl_ui_default_atlas.inl\""
+       (and the output directory on the include path) to use it
+     * rerun whenever the default font or the atlas layout changes (a stale
+       array is rejected by its key and the atlas is built normally)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] entry point
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include <stdio.h> // printf
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const char* pcOutput = argc > 1 ? argv[1] : "pl_ui_default_atlas.inl";
+
+    // alpha8 only: baked arrays store alpha8 pixels, the RGBA32 copy would be thrown away
+    static plFontAtlas tFontAtlas = {0};
+    tFontAtlas.bAlpha8Only = true;
+    pl_add_default_font(&tFontAtlas);
+    pl_build_font_atlas(&tFontAtlas);
+
+    const bool bSaved = pl_save_font_atlas_source(&tFontAtlas, pcOutput, "gauPlBakedDefaultAtlas");
+    if(bSaved)
+        printf("wrote %s (%u x %u atlas)\n", pcOutput, tFontAtlas.auAtlasSize[0], tFontAtlas.auAtlasSize[1]);
+    else
+        printf("could not write %s\n", pcOutput);
+
+    pl_cleanup_font_atlas(&tFontAtlas);
+    return bSaved ? 0 : 1;
+}
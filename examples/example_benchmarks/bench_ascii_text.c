@@ -0,0 +1,170 @@
+/*
+   ASCII text fast path benchmark
+     * ns per char for measuring (size, size with wrapping) & drawing (add,
+       clip) 2000 log style lines, with the dense ASCII tables ("ascii") and
+       with the general decode + codepoint page loop ("general", what every
+       char went through before the fast path & what dynamic fonts still use)
+     * both paths must produce identical sizes & vertices
+     * usage: ascii_text_benchmark [iterations]
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] globals
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_benchmark.h"
+
+#include <stdio.h>  // printf, snprintf
+#include <stdlib.h> // atoi
+#include <string.h> // strlen
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_LINE_COUNT 2000
+#define PL_LINE_BYTES 128
+
+//-----------------------------------------------------------------------------
+// [SECTION] globals
+//-----------------------------------------------------------------------------
+
+char       gaacLines[PL_LINE_COUNT][PL_LINE_BYTES];
+size_t     gszCharCount = 0;
+plDrawList gtDrawlist;
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+static void pl__run_cases(plFont* ptFont, uint32_t uIterations, double* adNsPerChar, uint64_t* pulHash);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const uint32_t uIterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 20u;
+
+    pl_create_context();
+
+    static plFontAtlas tFontAtlas = {0};
+    plFont* ptFont = pl_add_default_font(&tFontAtlas);
+    pl_build_font_atlas(&tFontAtlas);
+    pl_set_default_font(ptFont);
+    pl_register_drawlist(&gtDrawlist);
+
+    uint32_t uSeed = 1u;
+    for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+    {
+        const uint32_t uWorker = pl_benchmark_random(&uSeed) % 16;
+        const uint32_t uItems = pl_benchmark_random(&uSeed) % 10000;
+        const double dTime = (double)(pl_benchmark_random(&uSeed) % 100000) / 1000.0;
+        const uint32_t uQueue = pl_benchmark_random(&uSeed) % 512;
+        gszCharCount += (size_t)snprintf(gaacLines[i], PL_LINE_BYTES, "[%05u] INFO  worker-%02u: processed %u items in %.3f ms (queue=%u)", i, uWorker, uItems, dTime, uQueue);
+    }
+
+    // general path: the font without its ASCII table (restored before cleanup)
+    plFontAsciiTable* ptAsciiTable = ptFont->_ptAsciiTable;
+
+    double adAscii[4] = {0};
+    double adGeneral[4] = {0};
+    uint64_t ulAsciiHash = 0;
+    uint64_t ulGeneralHash = 0;
+    pl__run_cases(ptFont, 1, adAscii, &ulAsciiHash); // warm up
+    ptFont->_ptAsciiTable = NULL;
+    pl__run_cases(ptFont, uIterations, adGeneral, &ulGeneralHash);
+    ptFont->_ptAsciiTable = ptAsciiTable;
+    pl__run_cases(ptFont, uIterations, adAscii, &ulAsciiHash);
+
+    const char* apcNames[4] = {"size      ", "size, wrap", "add       ", "clip      "};
+    for(uint32_t i = 0; i < 4; i++)
+        printf("%s  general %6.2f  ascii %6.2f ns/char  (%.2fx)\n", apcNames[i], adGeneral[i], adAscii[i], adGeneral[i] / adAscii[i]);
+
+    const bool bMatch = ulAsciiHash == ulGeneralHash;
+    printf("outputs %s\n", bMatch ? "match" : "DIFFER");
+
+    pl_cleanup_font_atlas(&tFontAtlas);
+    pl_destroy_context();
+    return bMatch ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+// median ns/char of size, size with wrap, add & clip
+static void
+pl__run_cases(plFont* ptFont, uint32_t uIterations, double* adNsPerChar, uint64_t* pulHash)
+{
+    const plVec4 tColor = {1.0f, 1.0f, 1.0f, 1.0f};
+    const double dChars = (double)gszCharCount * (double)uIterations;
+    uint64_t ulHash = 14695981039346656037ull;
+
+    double aadSamples[4][PL_BENCHMARK_SAMPLES];
+    for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+    {
+        // measuring (wrap 0 & 200 px)
+        for(uint32_t uCase = 0; uCase < 2; uCase++)
+        {
+            const float fWrap = uCase == 0 ? 0.0f : 200.0f;
+            const double dStart = pl_benchmark_seconds();
+            for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+            {
+                for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+                {
+                    const plVec2 tSize = pl_calculate_text_size_ex(ptFont, 13.0f, gaacLines[i], gaacLines[i] + strlen(gaacLines[i]), fWrap);
+                    if(uSample == 0 && uIteration == 0)
+                        ulHash = pl_benchmark_hash(ulHash, &tSize, sizeof(plVec2));
+                }
+            }
+            aadSamples[uCase][uSample] = (pl_benchmark_seconds() - dStart) / dChars * 1e9;
+        }
+
+        // drawing (unclipped & 200 px wide clip rect)
+        for(uint32_t uCase = 2; uCase < 4; uCase++)
+        {
+            plDrawLayer* ptLayer = pl_request_layer(&gtDrawlist, "benchmark");
+            const double dStart = pl_benchmark_seconds();
+            for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+            {
+                for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+                {
+                    const plVec2 tPos = {10.0f, 10.0f + (float)i};
+                    const char* pcTextEnd = gaacLines[i] + strlen(gaacLines[i]);
+                    if(uCase == 3)
+                        pl_add_text_clipped_ex(ptLayer, ptFont, 13.0f, tPos, (plVec2){0.0f, 0.0f}, (plVec2){200.0f, 3000.0f}, tColor, gaacLines[i], pcTextEnd, 0.0f);
+                    else
+                        pl_add_text_ex(ptLayer, ptFont, 13.0f, tPos, tColor, gaacLines[i], pcTextEnd, 0.0f);
+                }
+                if(uSample == 0 && uIteration == 0)
+                {
+                    ulHash = pl_benchmark_hash(ulHash, ptLayer->sbtVertexBuffer, sizeof(plDrawVertex) * plu_sb_size(ptLayer->sbtVertexBuffer));
+                    ulHash = pl_benchmark_hash(ulHash, ptLayer->sbuIndexBuffer, sizeof(uint32_t) * plu_sb_size(ptLayer->sbuIndexBuffer));
+                }
+                pl_return_layer(ptLayer);
+                ptLayer = pl_request_layer(&gtDrawlist, "benchmark");
+            }
+            aadSamples[uCase][uSample] = (pl_benchmark_seconds() - dStart) / dChars * 1e9;
+            pl_return_layer(ptLayer);
+        }
+    }
+
+    for(uint32_t uCase = 0; uCase < 4; uCase++)
+        adNsPerChar[uCase] = pl_benchmark_median(aadSamples[uCase], PL_BENCHMARK_SAMPLES);
+    *pulHash = ulHash;
+}
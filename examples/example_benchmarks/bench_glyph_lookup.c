@@ -0,0 +1,200 @@
+/*
+   glyph lookup benchmark
+     * ns per codepoint for pl_calculate_text_size_ex() (size) & pl_add_text_ex() (add)
+     * ASCII text through a 1 range font & a 62 range font, then CJK heavy
+       text (80% from the last range) through the 62 range font
+     * usage: glyph_lookup_benchmark [ttf file] [iterations]
+       (glyphs missing from the font still go through the same lookup)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] globals
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_benchmark.h"
+
+#include <stdio.h>  // printf, fopen
+#include <stdlib.h> // atoi
+#include <string.h> // strlen
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_LINE_COUNT  1000
+#define PL_LINE_LENGTH 60 // codepoints
+#define PL_LINE_BYTES  256
+
+//-----------------------------------------------------------------------------
+// [SECTION] globals
+//-----------------------------------------------------------------------------
+
+char       gaacAsciiLines[PL_LINE_COUNT][PL_LINE_BYTES];
+char       gaacCjkLines[PL_LINE_COUNT][PL_LINE_BYTES];
+plDrawList gtDrawlist;
+uint64_t   gulChecksum = 14695981039346656037ull;
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+static uint32_t pl__encode_utf8(char* pcOut, uint32_t uCodePoint);
+static void     pl__run_case   (const char* pcName, plFont* ptFont, char (*aacLines)[PL_LINE_BYTES], uint32_t uIterations);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const char* pcFontFile = argc > 1 ? argv[1] : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+    const uint32_t uIterations = argc > 2 ? (uint32_t)atoi(argv[2]) : 40u;
+
+    FILE* ptFontFile = fopen(pcFontFile, "rb");
+    if(ptFontFile == NULL)
+    {
+        printf("could not open %s (usage: glyph_lookup_benchmark [ttf file] [iterations])\n", pcFontFile);
+        return 1;
+    }
+    fclose(ptFontFile);
+
+    pl_create_context();
+
+    // same text for every tree
+    uint32_t uSeed = 7u;
+    for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+    {
+        char* pcAscii = gaacAsciiLines[i];
+        char* pcCjk = gaacCjkLines[i];
+        for(uint32_t j = 0; j < PL_LINE_LENGTH; j++)
+        {
+            *pcAscii++ = (char)(0x21 + pl_benchmark_random(&uSeed) % 94);
+            if(pl_benchmark_random(&uSeed) % 5 != 0)
+                pcCjk += pl__encode_utf8(pcCjk, 0x4E00 + pl_benchmark_random(&uSeed) % 0x200);
+            else
+                pcCjk += pl__encode_utf8(pcCjk, 0x21 + pl_benchmark_random(&uSeed) % 94);
+        }
+    }
+
+    static plFontAtlas tFontAtlas = {0};
+    const plFontRange tAsciiRange = {.iFirstCodePoint = 0x20, .uCharCount = 0x7F - 0x20};
+
+    // font 0: one range
+    plFontConfig tConfig0 = {.fFontSize = 13.0f, .uHOverSampling = 1, .uVOverSampling = 1};
+    plu_sb_push(tConfig0.sbtRanges, tAsciiRange);
+    pl_add_font_from_file_ttf(&tFontAtlas, tConfig0, pcFontFile);
+
+    // font 1: ASCII first, 60 latin/greek/cyrillic slices, CJK last
+    plFontConfig tConfig1 = {.fFontSize = 13.0f, .uHOverSampling = 1, .uVOverSampling = 1};
+    plu_sb_push(tConfig1.sbtRanges, tAsciiRange);
+    for(int i = 0; i < 60; i++)
+    {
+        const plFontRange tRange = {.iFirstCodePoint = 0xA0 + i * 16, .uCharCount = 16};
+        plu_sb_push(tConfig1.sbtRanges, tRange);
+    }
+    const plFontRange tCjkRange = {.iFirstCodePoint = 0x4E00, .uCharCount = 0x200};
+    plu_sb_push(tConfig1.sbtRanges, tCjkRange);
+    pl_add_font_from_file_ttf(&tFontAtlas, tConfig1, pcFontFile);
+
+    pl_build_font_atlas(&tFontAtlas);
+    pl_set_default_font(PL_BENCHMARK_FONT(&tFontAtlas, 0));
+    pl_register_drawlist(&gtDrawlist);
+
+    // warm up (buffers reach their final size)
+    pl__run_case(NULL, PL_BENCHMARK_FONT(&tFontAtlas, 1), gaacCjkLines, 2);
+
+    pl__run_case("ascii, 1 range    ", PL_BENCHMARK_FONT(&tFontAtlas, 0), gaacAsciiLines, uIterations);
+    pl__run_case("ascii, 62 ranges  ", PL_BENCHMARK_FONT(&tFontAtlas, 1), gaacAsciiLines, uIterations);
+    pl__run_case("cjk 80%, 62 ranges", PL_BENCHMARK_FONT(&tFontAtlas, 1), gaacCjkLines, uIterations);
+    printf("checksum %016llx\n", (unsigned long long)gulChecksum);
+
+    pl_cleanup_font_atlas(&tFontAtlas);
+    pl_destroy_context();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__encode_utf8(char* pcOut, uint32_t uCodePoint)
+{
+    if(uCodePoint < 0x80)
+    {
+        pcOut[0] = (char)uCodePoint;
+        return 1;
+    }
+    if(uCodePoint < 0x800)
+    {
+        pcOut[0] = (char)(0xC0 | (uCodePoint >> 6));
+        pcOut[1] = (char)(0x80 | (uCodePoint & 0x3F));
+        return 2;
+    }
+    pcOut[0] = (char)(0xE0 | (uCodePoint >> 12));
+    pcOut[1] = (char)(0x80 | ((uCodePoint >> 6) & 0x3F));
+    pcOut[2] = (char)(0x80 | (uCodePoint & 0x3F));
+    return 3;
+}
+
+static void
+pl__run_case(const char* pcName, plFont* ptFont, char (*aacLines)[PL_LINE_BYTES], uint32_t uIterations)
+{
+    size_t szCodePoints = 0;
+    for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+    {
+        for(const char* pcChar = aacLines[i]; *pcChar; pcChar++)
+            szCodePoints += ((unsigned char)*pcChar & 0xC0) != 0x80;
+    }
+    const double dCodePoints = (double)szCodePoints * (double)uIterations;
+
+    double adSize[PL_BENCHMARK_SAMPLES];
+    double adAdd[PL_BENCHMARK_SAMPLES];
+    for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+    {
+        float fWidthSum = 0.0f;
+        const double dStart = pl_benchmark_seconds();
+        for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+        {
+            for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+                fWidthSum += pl_calculate_text_size_ex(ptFont, 13.0f, aacLines[i], aacLines[i] + strlen(aacLines[i]), 0.0f).x;
+        }
+        const double dSizeEnd = pl_benchmark_seconds();
+
+        plDrawLayer* ptLayer = pl_request_layer(&gtDrawlist, "benchmark");
+        for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+        {
+            for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+                pl_add_text_ex(ptLayer, ptFont, 13.0f, (plVec2){10.0f, 10.0f + (float)i}, (plVec4){1.0f, 1.0f, 1.0f, 1.0f}, aacLines[i], aacLines[i] + strlen(aacLines[i]), 0.0f);
+            const uint32_t uIndexCount = plu_sb_size(ptLayer->sbuIndexBuffer);
+            gulChecksum = pl_benchmark_hash(gulChecksum, &uIndexCount, sizeof(uint32_t));
+
+            // what a frame would do (older trees append layer vertices straight to the drawlist)
+            pl_return_layer(ptLayer);
+            ptLayer = pl_request_layer(&gtDrawlist, "benchmark");
+            plu_sb_reset(gtDrawlist.sbtVertexBuffer);
+        }
+        const double dAddEnd = pl_benchmark_seconds();
+        pl_return_layer(ptLayer);
+
+        gulChecksum = pl_benchmark_hash(gulChecksum, &fWidthSum, sizeof(float));
+        adSize[uSample] = (dSizeEnd - dStart) / dCodePoints * 1e9;
+        adAdd[uSample] = (dAddEnd - dSizeEnd) / dCodePoints * 1e9;
+    }
+
+    if(pcName)
+        printf("%s  size %7.2f  add %7.2f ns/codepoint\n", pcName, pl_benchmark_median(adSize, PL_BENCHMARK_SAMPLES), pl_benchmark_median(adAdd, PL_BENCHMARK_SAMPLES));
+}
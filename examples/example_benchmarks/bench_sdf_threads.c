@@ -0,0 +1,293 @@
+/*
+   SDF atlas build benchmark
+     * builds a 3000 glyph SDF font with pl_build_font_atlas(), serially
+       (no plJobSystem) & through a small pthread job system with 1, 2, 4
+       and 8 workers (the calling thread counts as one)
+     * reports glyphs per second & speedup over the serial build
+     * every threaded atlas must match the serial one (pixels & glyphs)
+     * usage: sdf_threads_benchmark [ttf file]
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] structs
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] job system
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_benchmark.h"
+
+#include <pthread.h> // pthread_create, pthread_mutex_t, pthread_cond_t
+#include <stdio.h>   // printf, fopen
+#include <string.h>  // memset
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_GLYPH_COUNT  3000
+#define PL_MAX_WORKERS  8
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plThreadPool
+{
+    pthread_t       atThreads[PL_MAX_WORKERS];
+    uint32_t        uThreadCount;   // workers besides the calling thread
+    pthread_mutex_t tMutex;
+    pthread_cond_t  tWorkCondition;
+    pthread_cond_t  tDoneCondition;
+
+    // current submission (guarded by tMutex, uNextJob is claimed atomically)
+    plJobFunction tFunction;
+    void*         pData;
+    uint32_t      uJobCount;
+    uint32_t      uNextJob;
+    uint32_t      uJobsDone;
+    uint32_t      uActiveWorkers;
+    uint32_t      uGeneration;      // bumped per submission
+    bool          bQuit;
+} plThreadPool;
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+// job system
+static void     pl__create_thread_pool (plThreadPool* ptPool, uint32_t uWorkerCount);
+static void     pl__destroy_thread_pool(plThreadPool* ptPool);
+static uint32_t pl__run_jobs           (plThreadPool* ptPool, plJobFunction tFunction, void* pData, uint32_t uJobCount);
+static void*    pl__submit_jobs        (void* pUserData, plJobFunction tFunction, void* pData, uint32_t uJobCount);
+static void     pl__wait_jobs          (void* pUserData, void* pHandle);
+static void*    pl__worker_main        (void* pData);
+
+// benchmark
+static double pl__build_atlas(const char* pcFontFile, uint64_t* pulHash);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const char* pcFontFile = argc > 1 ? argv[1] : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+
+    FILE* ptFontFile = fopen(pcFontFile, "rb");
+    if(ptFontFile == NULL)
+    {
+        printf("could not open %s (usage: sdf_threads_benchmark [ttf file])\n", pcFontFile);
+        return 1;
+    }
+    fclose(ptFontFile);
+
+    pl_create_context();
+    plIO* ptIO = pl_get_io();
+
+    // serial reference
+    double adSamples[PL_BENCHMARK_SAMPLES];
+    uint64_t ulSerialHash = 0;
+    for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+        adSamples[uSample] = pl__build_atlas(pcFontFile, &ulSerialHash);
+    const double dSerial = pl_benchmark_median(adSamples, PL_BENCHMARK_SAMPLES);
+    printf("serial     %8.0f glyphs/s\n", PL_GLYPH_COUNT / dSerial);
+
+    bool bPassed = true;
+    const uint32_t auWorkerCounts[] = {1, 2, 4, 8};
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        static plThreadPool tPool;
+        pl__create_thread_pool(&tPool, auWorkerCounts[i]);
+        plJobSystem tJobSystem = {
+            .submit_jobs_fn = pl__submit_jobs,
+            .wait_jobs_fn   = pl__wait_jobs,
+            .pUserData      = &tPool
+        };
+        ptIO->ptJobSystem = &tJobSystem;
+
+        bool bMatch = true;
+        for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+        {
+            uint64_t ulHash = 0;
+            adSamples[uSample] = pl__build_atlas(pcFontFile, &ulHash);
+            bMatch = bMatch && ulHash == ulSerialHash;
+        }
+        const double dThreaded = pl_benchmark_median(adSamples, PL_BENCHMARK_SAMPLES);
+        printf("%u worker%s  %8.0f glyphs/s  %5.2fx serial, atlas %s\n", auWorkerCounts[i], auWorkerCounts[i] == 1 ? " " : "s",
+            PL_GLYPH_COUNT / dThreaded, dSerial / dThreaded, bMatch ? "matches" : "DIFFERS");
+        bPassed = bPassed && bMatch;
+
+        ptIO->ptJobSystem = NULL;
+        pl__destroy_thread_pool(&tPool);
+    }
+
+    pl_destroy_context();
+    printf("%s\n", bPassed ? "PASSED" : "FAILED");
+    return bPassed ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] job system
+//-----------------------------------------------------------------------------
+
+static void
+pl__create_thread_pool(plThreadPool* ptPool, uint32_t uWorkerCount)
+{
+    memset(ptPool, 0, sizeof(plThreadPool));
+    pthread_mutex_init(&ptPool->tMutex, NULL);
+    pthread_cond_init(&ptPool->tWorkCondition, NULL);
+    pthread_cond_init(&ptPool->tDoneCondition, NULL);
+    ptPool->uThreadCount = uWorkerCount - 1;
+    for(uint32_t i = 0; i < ptPool->uThreadCount; i++)
+        pthread_create(&ptPool->atThreads[i], NULL, pl__worker_main, ptPool);
+}
+
+static void
+pl__destroy_thread_pool(plThreadPool* ptPool)
+{
+    pthread_mutex_lock(&ptPool->tMutex);
+    ptPool->bQuit = true;
+    pthread_cond_broadcast(&ptPool->tWorkCondition);
+    pthread_mutex_unlock(&ptPool->tMutex);
+    for(uint32_t i = 0; i < ptPool->uThreadCount; i++)
+        pthread_join(ptPool->atThreads[i], NULL);
+    pthread_mutex_destroy(&ptPool->tMutex);
+    pthread_cond_destroy(&ptPool->tWorkCondition);
+    pthread_cond_destroy(&ptPool->tDoneCondition);
+}
+
+// claims & runs jobs until none are left, returns how many were run
+static uint32_t
+pl__run_jobs(plThreadPool* ptPool, plJobFunction tFunction, void* pData, uint32_t uJobCount)
+{
+    uint32_t uDone = 0;
+    uint32_t uJob = 0;
+    while((uJob = __atomic_fetch_add(&ptPool->uNextJob, 1u, __ATOMIC_RELAXED)) < uJobCount)
+    {
+        tFunction(uJob, pData);
+        uDone++;
+    }
+    return uDone;
+}
+
+static void*
+pl__submit_jobs(void* pUserData, plJobFunction tFunction, void* pData, uint32_t uJobCount)
+{
+    plThreadPool* ptPool = pUserData;
+    pthread_mutex_lock(&ptPool->tMutex);
+
+    // late workers from the previous submission must be out before uNextJob is reset
+    while(ptPool->uActiveWorkers > 0)
+        pthread_cond_wait(&ptPool->tDoneCondition, &ptPool->tMutex);
+
+    ptPool->tFunction = tFunction;
+    ptPool->pData = pData;
+    ptPool->uJobCount = uJobCount;
+    ptPool->uJobsDone = 0;
+    __atomic_store_n(&ptPool->uNextJob, 0u, __ATOMIC_RELAXED);
+    ptPool->uGeneration++;
+    pthread_cond_broadcast(&ptPool->tWorkCondition);
+    pthread_mutex_unlock(&ptPool->tMutex);
+    return ptPool;
+}
+
+static void
+pl__wait_jobs(void* pUserData, void* pHandle)
+{
+    (void)pHandle;
+    plThreadPool* ptPool = pUserData;
+
+    // calling thread helps out
+    const uint32_t uDone = pl__run_jobs(ptPool, ptPool->tFunction, ptPool->pData, ptPool->uJobCount);
+
+    pthread_mutex_lock(&ptPool->tMutex);
+    ptPool->uJobsDone += uDone;
+    while(ptPool->uJobsDone < ptPool->uJobCount || ptPool->uActiveWorkers > 0)
+        pthread_cond_wait(&ptPool->tDoneCondition, &ptPool->tMutex);
+    pthread_mutex_unlock(&ptPool->tMutex);
+}
+
+static void*
+pl__worker_main(void* pData)
+{
+    plThreadPool* ptPool = pData;
+    uint32_t uSeenGeneration = 0;
+
+    pthread_mutex_lock(&ptPool->tMutex);
+    while(true)
+    {
+        while(!ptPool->bQuit && ptPool->uGeneration == uSeenGeneration)
+            pthread_cond_wait(&ptPool->tWorkCondition, &ptPool->tMutex);
+        if(ptPool->bQuit)
+            break;
+
+        // copied under the lock, the submission can't change while uActiveWorkers > 0
+        uSeenGeneration = ptPool->uGeneration;
+        const plJobFunction tFunction = ptPool->tFunction;
+        void* pJobData = ptPool->pData;
+        const uint32_t uJobCount = ptPool->uJobCount;
+        ptPool->uActiveWorkers++;
+        pthread_mutex_unlock(&ptPool->tMutex);
+
+        const uint32_t uDone = pl__run_jobs(ptPool, tFunction, pJobData, uJobCount);
+
+        pthread_mutex_lock(&ptPool->tMutex);
+        ptPool->uJobsDone += uDone;
+        ptPool->uActiveWorkers--;
+        pthread_cond_broadcast(&ptPool->tDoneCondition);
+    }
+    pthread_mutex_unlock(&ptPool->tMutex);
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+// returns seconds spent in pl_build_font_atlas(), *pulHash receives a hash of the result
+static double
+pl__build_atlas(const char* pcFontFile, uint64_t* pulHash)
+{
+    static plFontAtlas tFontAtlas;
+    memset(&tFontAtlas, 0, sizeof(plFontAtlas));
+    tFontAtlas.bAlpha8Only = true;
+
+    plFontConfig tConfig = {
+        .fFontSize      = 32.0f,
+        .uHOverSampling = 1,
+        .uVOverSampling = 1,
+        .bSdf           = true,
+        .iSdfPadding    = 4,
+        .ucOnEdgeValue  = 180
+    };
+    const plFontRange tRange = {.iFirstCodePoint = 0x20, .uCharCount = PL_GLYPH_COUNT};
+    plu_sb_push(tConfig.sbtRanges, tRange);
+    pl_add_font_from_file_ttf(&tFontAtlas, tConfig, pcFontFile);
+
+    const double dStart = pl_benchmark_seconds();
+    pl_build_font_atlas(&tFontAtlas);
+    const double dEnd = pl_benchmark_seconds();
+
+    const plFont* ptFont = PL_BENCHMARK_FONT(&tFontAtlas, 0);
+    uint64_t ulHash = 14695981039346656037ull;
+    ulHash = pl_benchmark_hash(ulHash, tFontAtlas.auAtlasSize, sizeof(uint32_t) * 2);
+    ulHash = pl_benchmark_hash(ulHash, tFontAtlas.pucPixelsAsAlpha8, (size_t)tFontAtlas.auAtlasSize[0] * tFontAtlas.auAtlasSize[1]);
+    ulHash = pl_benchmark_hash(ulHash, ptFont->sbtGlyphs, sizeof(plFontGlyph) * plu_sb_size(ptFont->sbtGlyphs));
+    ulHash = pl_benchmark_hash(ulHash, ptFont->sbtCharData, sizeof(plFontChar) * plu_sb_size(ptFont->sbtCharData));
+    *pulHash = ulHash;
+
+    pl_cleanup_font_atlas(&tFontAtlas);
+    return dEnd - dStart;
+}
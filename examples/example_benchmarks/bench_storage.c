@@ -0,0 +1,216 @@
+/*
+   state storage benchmark
+     * ns per operation for plUiStorage (hash map) against the sorted array
+       + binary search it replaced (kept below as plSortedStorage) at 1k,
+       10k & 100k entries
+     * insert: pl_get_int_ptr() with new keys, lookup hit/miss: pl_get_int()
+     * ids are hashes of "Tree Node %u" (misses use "Missing Node %u")
+     * both must return the same values for every key
+     * usage: storage_benchmark [lookups per case]
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] structs
+// [SECTION] globals
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] sorted storage
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_benchmark.h"
+
+#include <stdio.h>  // printf, snprintf
+#include <stdlib.h> // atoi
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_MAX_ENTRIES 100000
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+// plUiStorage before the hash map (sorted by key)
+typedef struct _plSortedStorage
+{
+    plUiStorageEntry* sbtData;
+} plSortedStorage;
+
+//-----------------------------------------------------------------------------
+// [SECTION] globals
+//-----------------------------------------------------------------------------
+
+uint32_t gauKeys[PL_MAX_ENTRIES];
+uint32_t gauMissingKeys[PL_MAX_ENTRIES];
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+// sorted storage
+static plUiStorageEntry* pl__sorted_lower_bound(plUiStorageEntry* sbtData, uint32_t uKey);
+static int               pl__sorted_get_int    (plSortedStorage* ptStorage, uint32_t uKey, int iDefaultValue);
+static int*              pl__sorted_get_int_ptr(plSortedStorage* ptStorage, uint32_t uKey, int iDefaultValue);
+
+// benchmark
+static bool pl__run_case(uint32_t uEntryCount, uint32_t uLookups);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const uint32_t uLookups = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000000u;
+
+    pl_create_context();
+
+    for(uint32_t i = 0; i < PL_MAX_ENTRIES; i++)
+    {
+        char acLabel[64];
+        snprintf(acLabel, 64, "Tree Node %u", i);
+        gauKeys[i] = plu_str_hash(acLabel, 0, 0);
+        snprintf(acLabel, 64, "Missing Node %u", i);
+        gauMissingKeys[i] = plu_str_hash(acLabel, 0, 0);
+    }
+
+    printf("entries  insert (sorted / hash)   lookup hit (sorted / hash)   lookup miss (sorted / hash)  ns/op\n");
+    bool bPassed = true;
+    bPassed = pl__run_case(1000, uLookups) && bPassed;
+    bPassed = pl__run_case(10000, uLookups) && bPassed;
+    bPassed = pl__run_case(100000, uLookups) && bPassed;
+
+    pl_destroy_context();
+    printf("%s\n", bPassed ? "PASSED" : "FAILED");
+    return bPassed ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] sorted storage
+//-----------------------------------------------------------------------------
+
+static plUiStorageEntry*
+pl__sorted_lower_bound(plUiStorageEntry* sbtData, uint32_t uKey)
+{
+    plUiStorageEntry* ptFirstEntry = sbtData;
+    uint32_t uCount = plu_sb_size(sbtData);
+    while (uCount > 0)
+    {
+        uint32_t uCount2 = uCount >> 1;
+        plUiStorageEntry* ptMiddleEntry = ptFirstEntry + uCount2;
+        if(ptMiddleEntry->uKey < uKey)
+        {
+            ptFirstEntry = ++ptMiddleEntry;
+            uCount -= uCount2 + 1;
+        }
+        else
+            uCount = uCount2;
+    }
+    return ptFirstEntry;
+}
+
+static int
+pl__sorted_get_int(plSortedStorage* ptStorage, uint32_t uKey, int iDefaultValue)
+{
+    plUiStorageEntry* ptIterator = pl__sorted_lower_bound(ptStorage->sbtData, uKey);
+    if((ptIterator == plu_sb_end(ptStorage->sbtData)) || (ptIterator->uKey != uKey))
+        return iDefaultValue;
+    return ptIterator->iValue;
+}
+
+static int*
+pl__sorted_get_int_ptr(plSortedStorage* ptStorage, uint32_t uKey, int iDefaultValue)
+{
+    plUiStorageEntry* ptIterator = pl__sorted_lower_bound(ptStorage->sbtData, uKey);
+    if(ptIterator == plu_sb_end(ptStorage->sbtData) || (ptIterator->uKey != uKey))
+    {
+        uint32_t uIndex = (uint32_t)((uintptr_t)ptIterator - (uintptr_t)ptStorage->sbtData) / (uint32_t)sizeof(plUiStorageEntry);
+        plu_sb_insert(ptStorage->sbtData, uIndex, ((plUiStorageEntry){.uKey = uKey, .iValue = iDefaultValue}));
+        ptIterator = &ptStorage->sbtData[uIndex];
+    }
+    return &ptIterator->iValue;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+// returns false if the two storages disagree
+static bool
+pl__run_case(uint32_t uEntryCount, uint32_t uLookups)
+{
+    double aadSamples[6][PL_BENCHMARK_SAMPLES];
+    bool bMatch = true;
+    for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+    {
+        plSortedStorage tSorted = {0};
+        plUiStorage tHash = {0};
+
+        // insert (value written through the pointer, like widgets do)
+        double dStart = pl_benchmark_seconds();
+        for(uint32_t i = 0; i < uEntryCount; i++)
+            *pl__sorted_get_int_ptr(&tSorted, gauKeys[i], 0) = (int)i;
+        aadSamples[0][uSample] = (pl_benchmark_seconds() - dStart) / uEntryCount * 1e9;
+
+        dStart = pl_benchmark_seconds();
+        for(uint32_t i = 0; i < uEntryCount; i++)
+            *pl_get_int_ptr(&tHash, gauKeys[i], 0) = (int)i;
+        aadSamples[1][uSample] = (pl_benchmark_seconds() - dStart) / uEntryCount * 1e9;
+
+        // lookups (hits, then misses)
+        for(uint32_t uCase = 0; uCase < 2; uCase++)
+        {
+            const uint32_t* auKeys = uCase == 0 ? gauKeys : gauMissingKeys;
+            int64_t ilSortedSum = 0;
+            int64_t ilHashSum = 0;
+
+            dStart = pl_benchmark_seconds();
+            for(uint32_t i = 0; i < uLookups; i++)
+                ilSortedSum += pl__sorted_get_int(&tSorted, auKeys[i % uEntryCount], -1);
+            aadSamples[2 + uCase * 2][uSample] = (pl_benchmark_seconds() - dStart) / uLookups * 1e9;
+
+            dStart = pl_benchmark_seconds();
+            for(uint32_t i = 0; i < uLookups; i++)
+                ilHashSum += pl_get_int(&tHash, auKeys[i % uEntryCount], -1);
+            aadSamples[3 + uCase * 2][uSample] = (pl_benchmark_seconds() - dStart) / uLookups * 1e9;
+
+            bMatch = bMatch && ilSortedSum == ilHashSum;
+        }
+
+        // every key, one by one
+        if(uSample == 0)
+        {
+            for(uint32_t i = 0; i < uEntryCount; i++)
+            {
+                bMatch = bMatch && pl__sorted_get_int(&tSorted, gauKeys[i], -1) == pl_get_int(&tHash, gauKeys[i], -1);
+                bMatch = bMatch && pl__sorted_get_int(&tSorted, gauMissingKeys[i], -1) == pl_get_int(&tHash, gauMissingKeys[i], -1);
+            }
+        }
+
+        plu_sb_free(tSorted.sbtData);
+        pl_cleanup_storage(&tHash);
+    }
+
+    double adMedians[6];
+    for(uint32_t i = 0; i < 6; i++)
+        adMedians[i] = pl_benchmark_median(aadSamples[i], PL_BENCHMARK_SAMPLES);
+    printf("%6u   %8.1f / %-6.1f (%5.1fx)   %8.1f / %-6.1f (%5.1fx)     %8.1f / %-6.1f (%5.1fx)   values %s\n", uEntryCount,
+        adMedians[0], adMedians[1], adMedians[0] / adMedians[1],
+        adMedians[2], adMedians[3], adMedians[2] / adMedians[3],
+        adMedians[4], adMedians[5], adMedians[4] / adMedians[5],
+        bMatch ? "match" : "DIFFER");
+    return bMatch;
+}
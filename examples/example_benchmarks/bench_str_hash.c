@@ -0,0 +1,184 @@
+/*
+   string hash benchmark
+     * ns per hash for plu_str_hash() against the byte at a time loop it
+       replaced (kept below as pl__str_hash_bytewise), for widget sized
+       labels, labels with a "###" id part & longer strings
+     * both must return the same ids for every string
+     * usage: str_hash_benchmark [iterations]
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] globals
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_benchmark.h"
+
+#include <stdio.h>  // printf
+#include <stdlib.h> // atoi
+#include <string.h> // memcpy, memset, memcmp, strlen
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_STRING_COUNT 1024
+#define PL_STRING_BYTES 512
+
+//-----------------------------------------------------------------------------
+// [SECTION] globals
+//-----------------------------------------------------------------------------
+
+char     gaacStrings[PL_STRING_COUNT][PL_STRING_BYTES];
+size_t   gaszLengths[PL_STRING_COUNT];
+uint32_t gauBytewiseIds[PL_STRING_COUNT];
+uint32_t gauCurrentIds[PL_STRING_COUNT];
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+static uint32_t pl__str_hash_bytewise(const char* pcData, size_t szDataSize, uint32_t uSeed);
+static bool     pl__run_case         (const char* pcName, uint32_t uMinLength, uint32_t uMaxLength, bool bIdPart, uint32_t uIterations);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const uint32_t uIterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 2000u;
+
+    // '#' runs & "###" at the edges
+    const char* apcEdgeCases[] = {"", "#", "##", "###", "####", "#####", "a###", "###a", "a##b", "a####b", "a###b###c", "##a###", "a#####b##", "######a"};
+    bool bPassed = true;
+    for(uint32_t i = 0; i < sizeof(apcEdgeCases) / sizeof(apcEdgeCases[0]); i++)
+    {
+        const size_t szLength = strlen(apcEdgeCases[i]);
+        const bool bMatch = plu_str_hash(apcEdgeCases[i], 0, 3u) == pl__str_hash_bytewise(apcEdgeCases[i], 0, 3u) &&
+            (szLength == 0 || plu_str_hash(apcEdgeCases[i], szLength, 3u) == pl__str_hash_bytewise(apcEdgeCases[i], szLength, 3u));
+        if(!bMatch)
+            printf("\"%s\" ids DIFFER\n", apcEdgeCases[i]);
+        bPassed = bPassed && bMatch;
+    }
+
+    bPassed = pl__run_case("labels 6-24 bytes     ", 6, 24, false, uIterations) && bPassed;
+    bPassed = pl__run_case("labels with ###       ", 6, 24, true, uIterations) && bPassed;
+    bPassed = pl__run_case("strings 64-128 bytes  ", 64, 128, false, uIterations / 4 + 1) && bPassed;
+    bPassed = pl__run_case("strings 256-500 bytes ", 256, 500, false, uIterations / 16 + 1) && bPassed;
+    printf("%s\n", bPassed ? "PASSED" : "FAILED");
+    return bPassed ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+// plu_str_hash() before slice-by-8 (one table lookup per byte)
+static uint32_t
+pl__str_hash_bytewise(const char* pcData, size_t szDataSize, uint32_t uSeed)
+{
+    uSeed = ~uSeed;
+    uint32_t uCrc = uSeed;
+    const unsigned char* pucData = (const unsigned char*)pcData;
+    const uint32_t* puCrc32Lut = gauiCrc32LUT[0];
+    if (szDataSize != 0)
+    {
+        while (szDataSize-- != 0)
+        {
+            unsigned char c = *pucData++;
+            if (c == '#' && szDataSize >= 2 && pucData[0] == '#' && pucData[1] == '#')
+                uCrc = uSeed;
+            uCrc = (uCrc >> 8) ^ puCrc32Lut[(uCrc & 0xFF) ^ c];
+        }
+    }
+    else
+    {
+        unsigned char c = *pucData++;
+        while (c)
+        {
+            if (c == '#' && pucData[0] == '#' && pucData[1] == '#')
+                uCrc = uSeed;
+            uCrc = (uCrc >> 8) ^ puCrc32Lut[(uCrc & 0xFF) ^ c];
+            c = *pucData;
+            pucData++;
+        }
+    }
+    return ~uCrc;
+}
+
+// returns false if the two hashes disagree
+static bool
+pl__run_case(const char* pcName, uint32_t uMinLength, uint32_t uMaxLength, bool bIdPart, uint32_t uIterations)
+{
+    // printable text, optionally "label###id" style
+    memset(gauBytewiseIds, 0, sizeof(gauBytewiseIds));
+    memset(gauCurrentIds, 0, sizeof(gauCurrentIds));
+    uint32_t uSeed = uMinLength * 31u + uMaxLength + (bIdPart ? 7u : 0u);
+    size_t szTotalBytes = 0;
+    for(uint32_t i = 0; i < PL_STRING_COUNT; i++)
+    {
+        const uint32_t uLength = uMinLength + pl_benchmark_random(&uSeed) % (uMaxLength - uMinLength + 1);
+        for(uint32_t j = 0; j < uLength; j++)
+            gaacStrings[i][j] = (char)(0x20 + pl_benchmark_random(&uSeed) % 0x5F);
+        if(bIdPart)
+            memcpy(&gaacStrings[i][uLength / 2], "###", 3);
+        gaacStrings[i][uLength] = 0;
+        gaszLengths[i] = uLength;
+        szTotalBytes += uLength;
+    }
+
+    // ids must not change (null terminated & sized, several seeds)
+    bool bMatch = true;
+    for(uint32_t i = 0; i < PL_STRING_COUNT; i++)
+    {
+        const uint32_t uIdSeed = i * 2654435761u;
+        bMatch = bMatch && plu_str_hash(gaacStrings[i], 0, uIdSeed) == pl__str_hash_bytewise(gaacStrings[i], 0, uIdSeed);
+        bMatch = bMatch && plu_str_hash(gaacStrings[i], gaszLengths[i], uIdSeed) == pl__str_hash_bytewise(gaacStrings[i], gaszLengths[i], uIdSeed);
+    }
+
+    // null terminated, like widget labels
+    double adBytewise[PL_BENCHMARK_SAMPLES];
+    double adCurrent[PL_BENCHMARK_SAMPLES];
+    const double dHashes = (double)PL_STRING_COUNT * (double)uIterations;
+    for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+    {
+        double dStart = pl_benchmark_seconds();
+        for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+        {
+            for(uint32_t i = 0; i < PL_STRING_COUNT; i++)
+                gauBytewiseIds[i] ^= pl__str_hash_bytewise(gaacStrings[i], 0, uIteration);
+        }
+        adBytewise[uSample] = (pl_benchmark_seconds() - dStart) / dHashes * 1e9;
+
+        dStart = pl_benchmark_seconds();
+        for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+        {
+            for(uint32_t i = 0; i < PL_STRING_COUNT; i++)
+                gauCurrentIds[i] ^= plu_str_hash(gaacStrings[i], 0, uIteration);
+        }
+        adCurrent[uSample] = (pl_benchmark_seconds() - dStart) / dHashes * 1e9;
+    }
+
+    // the timed loops also keep their results so the compiler can't drop them
+    bMatch = bMatch && memcmp(gauBytewiseIds, gauCurrentIds, sizeof(gauCurrentIds)) == 0;
+
+    const double dBytewise = pl_benchmark_median(adBytewise, PL_BENCHMARK_SAMPLES);
+    const double dCurrent = pl_benchmark_median(adCurrent, PL_BENCHMARK_SAMPLES);
+    const double dAverageLength = (double)szTotalBytes / PL_STRING_COUNT;
+    printf("%s bytewise %7.2f  slice-by-8 %7.2f ns/hash  (%.2fx, %.1f bytes avg), ids %s\n", pcName, dBytewise, dCurrent,
+        dBytewise / dCurrent, dAverageLength, bMatch ? "match" : "DIFFER");
+    return bMatch;
+}
@@ -0,0 +1,146 @@
+/*
+   text emission benchmark
+     * glyphs per second & ns per char for pl_add_text_ex() (add) and
+       pl_add_text_clipped_ex() (clip) over 2000 log style lines
+     * clip keeps the glyphs inside a 200 px wide rect, its glyphs per
+       second count kept glyphs only
+     * usage: text_emit_benchmark [iterations]
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] globals
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_benchmark.h"
+
+#include <stdio.h>  // printf, snprintf
+#include <stdlib.h> // atoi
+#include <string.h> // strlen
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_LINE_COUNT 2000
+#define PL_LINE_BYTES 128
+
+//-----------------------------------------------------------------------------
+// [SECTION] globals
+//-----------------------------------------------------------------------------
+
+char       gaacLines[PL_LINE_COUNT][PL_LINE_BYTES];
+size_t     gszCharCount = 0;
+plDrawList gtDrawlist;
+uint64_t   gulChecksum = 14695981039346656037ull;
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+static double pl__emit_text(plFont* ptFont, bool bClipped, uint32_t uIterations, uint64_t* pulGlyphs);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    const uint32_t uIterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 30u;
+
+    pl_create_context();
+
+    static plFontAtlas tFontAtlas = {0};
+    pl_add_default_font(&tFontAtlas);
+    pl_build_font_atlas(&tFontAtlas);
+    plFont* ptFont = PL_BENCHMARK_FONT(&tFontAtlas, 0);
+    pl_set_default_font(ptFont);
+    pl_register_drawlist(&gtDrawlist);
+
+    // same text for every tree
+    uint32_t uSeed = 1u;
+    for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+    {
+        const uint32_t uWorker = pl_benchmark_random(&uSeed) % 16;
+        const uint32_t uItems = pl_benchmark_random(&uSeed) % 10000;
+        const double dTime = (double)(pl_benchmark_random(&uSeed) % 100000) / 1000.0;
+        const uint32_t uQueue = pl_benchmark_random(&uSeed) % 512;
+        gszCharCount += (size_t)snprintf(gaacLines[i], PL_LINE_BYTES, "[%05u] INFO  worker-%02u: processed %u items in %.3f ms (queue=%u)", i, uWorker, uItems, dTime, uQueue);
+    }
+
+    // warm up (buffers reach their final size)
+    uint64_t ulGlyphs = 0;
+    uint64_t ulClippedGlyphs = 0;
+    pl__emit_text(ptFont, false, 1, &ulGlyphs);
+    pl__emit_text(ptFont, true, 1, &ulClippedGlyphs);
+
+    double adAdd[PL_BENCHMARK_SAMPLES];
+    double adClip[PL_BENCHMARK_SAMPLES];
+    for(uint32_t uSample = 0; uSample < PL_BENCHMARK_SAMPLES; uSample++)
+    {
+        adAdd[uSample] = pl__emit_text(ptFont, false, uIterations, &ulGlyphs);
+        adClip[uSample] = pl__emit_text(ptFont, true, uIterations, &ulClippedGlyphs);
+    }
+    const double dAdd = pl_benchmark_median(adAdd, PL_BENCHMARK_SAMPLES);
+    const double dClip = pl_benchmark_median(adClip, PL_BENCHMARK_SAMPLES);
+    const double dChars = (double)gszCharCount * (double)uIterations;
+
+    printf("add   %7.2f Mglyphs/s  %7.2f ns/char\n", (double)ulGlyphs * uIterations / dAdd * 1e-6, dAdd / dChars * 1e9);
+    printf("clip  %7.2f Mglyphs/s  %7.2f ns/char (%llu of %llu glyphs kept)\n", (double)ulClippedGlyphs * uIterations / dClip * 1e-6, dClip / dChars * 1e9,
+        (unsigned long long)ulClippedGlyphs, (unsigned long long)ulGlyphs);
+    printf("checksum %016llx\n", (unsigned long long)gulChecksum);
+
+    pl_cleanup_font_atlas(&tFontAtlas);
+    pl_destroy_context();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+// returns seconds, *pulGlyphs receives the glyphs emitted per iteration
+static double
+pl__emit_text(plFont* ptFont, bool bClipped, uint32_t uIterations, uint64_t* pulGlyphs)
+{
+    const plVec4 tColor = {1.0f, 1.0f, 1.0f, 1.0f};
+    plDrawLayer* ptLayer = pl_request_layer(&gtDrawlist, "benchmark");
+
+    const double dStart = pl_benchmark_seconds();
+    for(uint32_t uIteration = 0; uIteration < uIterations; uIteration++)
+    {
+        for(uint32_t i = 0; i < PL_LINE_COUNT; i++)
+        {
+            const plVec2 tPos = {10.0f, 10.0f + (float)i};
+            const char* pcTextEnd = gaacLines[i] + strlen(gaacLines[i]);
+            if(bClipped)
+                pl_add_text_clipped_ex(ptLayer, ptFont, 13.0f, tPos, (plVec2){0.0f, 0.0f}, (plVec2){200.0f, 3000.0f}, tColor, gaacLines[i], pcTextEnd, 0.0f);
+            else
+                pl_add_text_ex(ptLayer, ptFont, 13.0f, tPos, tColor, gaacLines[i], pcTextEnd, 0.0f);
+        }
+        const uint32_t uIndexCount = plu_sb_size(ptLayer->sbuIndexBuffer);
+        gulChecksum = pl_benchmark_hash(gulChecksum, &uIndexCount, sizeof(uint32_t));
+        *pulGlyphs = uIndexCount / 6;
+
+        // what a frame would do (older trees append layer vertices straight to the drawlist)
+        pl_return_layer(ptLayer);
+        ptLayer = pl_request_layer(&gtDrawlist, "benchmark");
+        plu_sb_reset(gtDrawlist.sbtVertexBuffer);
+    }
+    const double dEnd = pl_benchmark_seconds();
+
+    pl_return_layer(ptLayer);
+    return dEnd - dStart;
+}
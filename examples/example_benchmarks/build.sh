@@ -0,0 +1,77 @@
+#!/bin/bash
+
+# usage: ./build.sh [pl_ui source directory] [benchmark ...]
+#   * the source directory defaults to this repo, pass an older checkout
+#     (e.g. from "git worktree add") to measure it with the same benchmarks
+#   * every benchmark is built when none are named
+
+# colors
+BOLD=$'\e[0;1m'
+RED=$'\e[0;31m'
+GREEN=$'\e[0;32m'
+CYAN=$'\e[0;36m'
+NC=$'\e[0m'
+
+# find directory of this script
+SOURCE=${BASH_SOURCE[0]}
+while [ -h "$SOURCE" ]; do # resolve $SOURCE until the file is no longer a symlink
+  DIR=$( cd -P "$( dirname "$SOURCE" )" >/dev/null 2>&1 && pwd )
+  SOURCE=$(readlink "$SOURCE")
+  [[ $SOURCE != /* ]] && SOURCE=$DIR/$SOURCE # if $SOURCE was a relative symlink, we need to resolve it relative to the path where the symlink file was located
+done
+DIR=$( cd -P "$( dirname "$SOURCE" )" >/dev/null 2>&1 && pwd )
+
+# pl_ui sources (resolved before the CWD changes)
+PL_UI_DIR=$( cd "${1:-$DIR/../..}" >/dev/null 2>&1 && pwd )
+shift
+PL_BENCHMARKS=${@:-"glyph_lookup text_emit sdf_threads ascii_text str_hash storage"}
+
+# make script directory CWD
+pushd $DIR >/dev/null
+
+# create output directory
+if ! [[ -d "../out" ]]; then
+    mkdir "../out"
+fi
+
+# preprocessor defines
+PL_DEFINES="-D_USE_MATH_DEFINES -DNDEBUG "
+
+# older trees keep fonts by value
+if ! grep -q "plFont\*\* *sbtFonts" "$PL_UI_DIR/pl_ui.h"; then
+    PL_DEFINES+="-DPL_BENCHMARK_FONTS_BY_VALUE "
+fi
+
+# includes directories
+PL_INCLUDE_DIRECTORIES="-I. -I$PL_UI_DIR "
+
+# compiler flags
+PL_COMPILER_FLAGS="-std=gnu99 -O2 "
+
+# linker flags
+PL_LINKER_FLAGS="-lm -lpthread "
+
+# default compilation result
+PL_RESULT=${BOLD}${GREEN}Successful.${NC}
+
+PL_SOURCES="$PL_UI_DIR/pl_ui_draw.c $PL_UI_DIR/pl_ui.c $PL_UI_DIR/pl_ui_widgets.c "
+
+# run compiler (and linker)
+echo
+echo ${CYAN}Compiling and Linking against $PL_UI_DIR...${NC}
+for PL_BENCHMARK in $PL_BENCHMARKS; do
+    rm -f ../out/${PL_BENCHMARK}_benchmark
+    cc bench_$PL_BENCHMARK.c $PL_SOURCES $PL_INCLUDE_DIRECTORIES $PL_DEFINES $PL_COMPILER_FLAGS $PL_LINKER_FLAGS -o "../out/${PL_BENCHMARK}_benchmark"
+
+    # check build status
+    if [ $? -ne 0 ]
+    then
+        PL_RESULT=${BOLD}${RED}Failed.${NC}
+    fi
+done
+
+# print results
+echo ${CYAN}Results: ${NC} ${PL_RESULT}
+
+# return CWD to previous CWD
+popd >/dev/null
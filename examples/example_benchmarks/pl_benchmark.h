@@ -0,0 +1,92 @@
+/*
+   pl_benchmark.h
+     * timing & reporting helpers shared by the benchmarks in this directory
+     * build.sh can point the benchmarks at an older checkout, the defines
+       below cover API differences between those trees
+*/
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] helpers
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_BENCHMARK_H
+#define PL_BENCHMARK_H
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint32_t, uint64_t
+#include <time.h>   // clock_gettime
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+// number of timed samples per case (median is reported)
+#ifndef PL_BENCHMARK_SAMPLES
+    #define PL_BENCHMARK_SAMPLES 5
+#endif
+
+// older trees keep fonts by value in plFontAtlas::sbtFonts (build.sh detects this)
+#ifdef PL_BENCHMARK_FONTS_BY_VALUE
+    #define PL_BENCHMARK_FONT(ptAtlas, uIndex) (&(ptAtlas)->sbtFonts[(uIndex)])
+#else
+    #define PL_BENCHMARK_FONT(ptAtlas, uIndex) ((ptAtlas)->sbtFonts[(uIndex)])
+#endif
+
+//-----------------------------------------------------------------------------
+// [SECTION] helpers
+//-----------------------------------------------------------------------------
+
+static inline double
+pl_benchmark_seconds(void)
+{
+    struct timespec tNow;
+    clock_gettime(CLOCK_MONOTONIC, &tNow);
+    return (double)tNow.tv_sec + (double)tNow.tv_nsec * 1e-9;
+}
+
+static inline double
+pl_benchmark_median(double* adSamples, uint32_t uCount)
+{
+    // few samples, insertion sort is fine
+    for(uint32_t i = 1; i < uCount; i++)
+    {
+        const double dValue = adSamples[i];
+        uint32_t j = i;
+        for(; j > 0 && adSamples[j - 1] > dValue; j--)
+            adSamples[j] = adSamples[j - 1];
+        adSamples[j] = dValue;
+    }
+    return uCount % 2 ? adSamples[uCount / 2] : 0.5 * (adSamples[uCount / 2 - 1] + adSamples[uCount / 2]);
+}
+
+// deterministic across platforms (unlike rand())
+static inline uint32_t
+pl_benchmark_random(uint32_t* puState)
+{
+    *puState = *puState * 1664525u + 1013904223u;
+    return *puState >> 8;
+}
+
+// FNV-1a, outputs are compared across trees & thread counts
+static inline uint64_t
+pl_benchmark_hash(uint64_t ulHash, const void* pData, size_t szSize)
+{
+    const unsigned char* pucData = pData;
+    for(size_t i = 0; i < szSize; i++)
+        ulHash = (ulHash ^ pucData[i]) * 1099511628211ull;
+    return ulHash;
+}
+
+#endif // PL_BENCHMARK_H
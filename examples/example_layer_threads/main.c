@@ -0,0 +1,256 @@
+/*
+   layer threading stress test (headless, software backend)
+     * fills N layers from several threads, then the same N layers serially
+     * both drawlists must compile to identical buffers & identical pixels
+     * allocation counters must agree (they are bumped from every thread)
+     * build.sh compiles with -fsanitize=thread, so any race is reported
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] structs
+// [SECTION] globals
+// [SECTION] forward declarations
+// [SECTION] entry point
+// [SECTION] implementations
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ui.h"
+#include "pl_ui_internal.h"
+#include "pl_ui_software.h"
+
+#include <pthread.h> // pthread_create, pthread_join
+#include <stdio.h>   // printf
+#include <stdlib.h>  // calloc, free
+#include <string.h>  // memcmp
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_LAYER_COUNT     16
+#define PL_THREAD_COUNT    4
+#define PL_ITERATION_COUNT 6
+#define PL_TILE_COLUMNS    4
+#define PL_TILE_WIDTH      256.0f
+#define PL_TILE_HEIGHT     192.0f
+#define PL_WIDTH           1024
+#define PL_HEIGHT          768
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plThreadData
+{
+    uint32_t uThreadIndex;
+    uint32_t uIteration;
+} plThreadData;
+
+//-----------------------------------------------------------------------------
+// [SECTION] globals
+//-----------------------------------------------------------------------------
+
+plDrawList   gtSerialDrawlist;
+plDrawList   gtThreadedDrawlist;
+plDrawLayer* gaptSerialLayers[PL_LAYER_COUNT];
+plDrawLayer* gaptThreadedLayers[PL_LAYER_COUNT];
+plFont*      gptFont = NULL;
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+static void  pl__fill_layer   (plDrawLayer* ptLayer, uint32_t uLayerIndex, uint32_t uIteration);
+static void* pl__thread_main  (void* pData);
+static bool  pl__compare_lists(const plDrawList* ptDrawlist0, const plDrawList* ptDrawlist1);
+
+//-----------------------------------------------------------------------------
+// [SECTION] entry point
+//-----------------------------------------------------------------------------
+
+int
+main(void)
+{
+    plUiContext* ptCtx = pl_create_context();
+    plIO* ptIO = pl_get_io();
+    ptIO->afMainViewportSize[0] = (float)PL_WIDTH;
+    ptIO->afMainViewportSize[1] = (float)PL_HEIGHT;
+
+    pl_initialize_software();
+
+    // static font only (dynamic fonts are main thread only)
+    static plFontAtlas tFontAtlas = {0};
+    gptFont = pl_add_default_font(&tFontAtlas);
+    pl_build_font_atlas(&tFontAtlas);
+    pl_create_software_font_texture(&tFontAtlas);
+    pl_set_default_font(gptFont);
+
+    pl_register_drawlist(&gtSerialDrawlist);
+    pl_register_drawlist(&gtThreadedDrawlist);
+    for(uint32_t i = 0; i < PL_LAYER_COUNT; i++)
+    {
+        gaptSerialLayers[i] = pl_request_layer(&gtSerialDrawlist, "serial layer");
+        gaptThreadedLayers[i] = pl_request_layer(&gtThreadedDrawlist, "threaded layer");
+    }
+
+    unsigned char* pucSerialPixels = calloc(PL_WIDTH * PL_HEIGHT * 4, 1);
+    unsigned char* pucThreadedPixels = calloc(PL_WIDTH * PL_HEIGHT * 4, 1);
+
+    bool bPassed = true;
+    for(uint32_t uIteration = 0; uIteration < PL_ITERATION_COUNT; uIteration++)
+    {
+        ptIO->dTime += 1.0 / 60.0;
+        ptIO->fDeltaTime = 1.0f / 60.0f;
+        ptIO->fCircleTessellationMaxError = 0.2f + 0.1f * (float)(uIteration % 3); // picked up by pl_new_frame()
+        pl_new_draw_frame_software();
+        pl_new_frame();
+
+        // threads first, so nothing shared was touched by the serial pass yet
+        // (work grows every iteration so layer buffers keep growing)
+        const uint32_t uThreadedAllocations = ptCtx->uFrameMemoryAllocations;
+        pthread_t atThreads[PL_THREAD_COUNT];
+        plThreadData atThreadData[PL_THREAD_COUNT];
+        for(uint32_t i = 0; i < PL_THREAD_COUNT; i++)
+        {
+            atThreadData[i].uThreadIndex = i;
+            atThreadData[i].uIteration = uIteration;
+            pthread_create(&atThreads[i], NULL, pl__thread_main, &atThreadData[i]);
+        }
+        for(uint32_t i = 0; i < PL_THREAD_COUNT; i++)
+            pthread_join(atThreads[i], NULL);
+        const uint32_t uThreadedDelta = ptCtx->uFrameMemoryAllocations - uThreadedAllocations;
+
+        // serial reference
+        const uint32_t uSerialAllocations = ptCtx->uFrameMemoryAllocations;
+        for(uint32_t i = 0; i < PL_LAYER_COUNT; i++)
+            pl__fill_layer(gaptSerialLayers[i], i, uIteration);
+        const uint32_t uSerialDelta = ptCtx->uFrameMemoryAllocations - uSerialAllocations;
+
+        // submission & compiling stay on the main thread
+        for(uint32_t i = 0; i < PL_LAYER_COUNT; i++)
+        {
+            pl_submit_layer(gaptSerialLayers[i]);
+            pl_submit_layer(gaptThreadedLayers[i]);
+        }
+        pl_compile_drawlist(&gtSerialDrawlist);
+        pl_compile_drawlist(&gtThreadedDrawlist);
+        pl_render();
+
+        memset(pucSerialPixels, 0, PL_WIDTH * PL_HEIGHT * 4);
+        memset(pucThreadedPixels, 0, PL_WIDTH * PL_HEIGHT * 4);
+        pl_submit_software_drawlist(&gtSerialDrawlist, (float)PL_WIDTH, (float)PL_HEIGHT, pucSerialPixels);
+        pl_submit_software_drawlist(&gtThreadedDrawlist, (float)PL_WIDTH, (float)PL_HEIGHT, pucThreadedPixels);
+
+        const bool bBuffersMatch = pl__compare_lists(&gtSerialDrawlist, &gtThreadedDrawlist);
+        const bool bPixelsMatch = memcmp(pucSerialPixels, pucThreadedPixels, PL_WIDTH * PL_HEIGHT * 4) == 0;
+        const bool bAllocationsMatch = uSerialDelta == uThreadedDelta;
+        const bool bIterationPassed = bBuffersMatch && bPixelsMatch && bAllocationsMatch;
+        bPassed = bPassed && bIterationPassed;
+
+        printf("iteration %u: %u vertices, %u indices, allocations %u serial / %u threaded, buffers %s, pixels %s -> %s\n",
+            uIteration, plu_sb_size(gtSerialDrawlist.sbtVertexBuffer), plu_sb_size(gtSerialDrawlist.sbuIndexBuffer),
+            uSerialDelta, uThreadedDelta, bBuffersMatch ? "match" : "DIFFER", bPixelsMatch ? "match" : "DIFFER",
+            bIterationPassed ? "ok" : "FAILED");
+    }
+
+    free(pucSerialPixels);
+    free(pucThreadedPixels);
+    pl_cleanup_software_font_texture(&tFontAtlas);
+    pl_cleanup_font_atlas(&tFontAtlas);
+    pl_cleanup_software();
+    pl_destroy_context();
+
+    printf("%s\n", bPassed ? "PASSED" : "FAILED");
+    return bPassed ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] implementations
+//-----------------------------------------------------------------------------
+
+static void*
+pl__thread_main(void* pData)
+{
+    const plThreadData* ptData = pData;
+    for(uint32_t i = ptData->uThreadIndex; i < PL_LAYER_COUNT; i += PL_THREAD_COUNT)
+        pl__fill_layer(gaptThreadedLayers[i], i, ptData->uIteration);
+    return NULL;
+}
+
+static void
+pl__fill_layer(plDrawLayer* ptLayer, uint32_t uLayerIndex, uint32_t uIteration)
+{
+    const plVec2 tOrigin = {
+        (float)(uLayerIndex % PL_TILE_COLUMNS) * PL_TILE_WIDTH,
+        (float)(uLayerIndex / PL_TILE_COLUMNS) * PL_TILE_HEIGHT
+    };
+    const uint32_t uItemCount = 64u * (uIteration + 1u);
+
+    pl_push_layer_clip_rect(ptLayer, (plRect){tOrigin, {tOrigin.x + PL_TILE_WIDTH, tOrigin.y + PL_TILE_HEIGHT}}, false);
+    for(uint32_t i = 0; i < uItemCount; i++)
+    {
+        // deterministic pseudo random placement (same sequence on every thread)
+        uint32_t uSeed = (uLayerIndex * 7919u + uIteration * 104729u + i) * 2654435761u;
+        uSeed ^= uSeed >> 15;
+        const float fX = tOrigin.x + (float)(uSeed % 240u);
+        const float fY = tOrigin.y + (float)((uSeed >> 8) % 176u);
+        const float fRadius = 1.0f + (float)((uSeed >> 4) % 600u) * 0.25f; // integer & fractional radii
+        const uint32_t uSegments = (uSeed >> 20) % 3u == 0 ? 3u + (uSeed >> 12) % 60u : 0u; // explicit & automatic
+        const uint32_t uColor = uSeed | 0xFF000000u;
+
+        switch(i % 8)
+        {
+            case 0: pl_add_rect_filled_u32(ptLayer, (plVec2){fX, fY}, (plVec2){fX + 12.0f, fY + 8.0f}, uColor); break;
+            case 1: pl_add_rect_rounded_filled_u32(ptLayer, (plVec2){fX, fY}, (plVec2){fX + 40.0f, fY + 24.0f}, uColor, fRadius * 0.1f, uSegments / 4u); break;
+            case 2: pl_add_circle_filled_u32(ptLayer, (plVec2){fX, fY}, fRadius * 0.2f, uColor, uSegments); break;
+            case 3: pl_add_circle_u32(ptLayer, (plVec2){fX, fY}, fRadius, uColor, uSegments, 1.0f); break;
+            case 4: pl_add_line_u32(ptLayer, (plVec2){fX, fY}, (plVec2){fX + 30.0f, fY + 10.0f}, uColor, 2.0f); break;
+            case 5: pl_add_bezier_cubic_u32(ptLayer, (plVec2){fX, fY}, (plVec2){fX + 10.0f, fY - 20.0f}, (plVec2){fX + 20.0f, fY + 20.0f}, (plVec2){fX + 30.0f, fY}, uColor, 1.5f, 0); break;
+            case 6: pl_add_triangle_filled_u32(ptLayer, (plVec2){fX, fY}, (plVec2){fX + 10.0f, fY + 16.0f}, (plVec2){fX - 10.0f, fY + 16.0f}, uColor); break;
+            case 7:
+            {
+                char acText[64];
+                snprintf(acText, 64, "layer %u item %u", uLayerIndex, i);
+                pl_push_layer_clip_rect(ptLayer, (plRect){{fX, fY}, {fX + 60.0f, fY + 20.0f}}, true);
+                pl_add_text(ptLayer, gptFont, 13.0f, (plVec2){fX, fY}, (plVec4){1.0f, 1.0f, 1.0f, 1.0f}, acText, 0.0f);
+                pl_pop_layer_clip_rect(ptLayer);
+                break;
+            }
+        }
+    }
+    pl_pop_layer_clip_rect(ptLayer);
+}
+
+static bool
+pl__compare_lists(const plDrawList* ptDrawlist0, const plDrawList* ptDrawlist1)
+{
+    const uint32_t uVertexCount = plu_sb_size(ptDrawlist0->sbtVertexBuffer);
+    const uint32_t uIndexCount = plu_sb_size(ptDrawlist0->sbuIndexBuffer);
+    const uint32_t uCommandCount = plu_sb_size(ptDrawlist0->sbtDrawCommands);
+    if(uVertexCount != plu_sb_size(ptDrawlist1->sbtVertexBuffer) || uIndexCount != plu_sb_size(ptDrawlist1->sbuIndexBuffer) || uCommandCount != plu_sb_size(ptDrawlist1->sbtDrawCommands))
+        return false;
+
+    if(uVertexCount > 0 && memcmp(ptDrawlist0->sbtVertexBuffer, ptDrawlist1->sbtVertexBuffer, uVertexCount * sizeof(plDrawVertex)) != 0)
+        return false;
+    if(uIndexCount > 0 && memcmp(ptDrawlist0->sbuIndexBuffer, ptDrawlist1->sbuIndexBuffer, uIndexCount * sizeof(uint32_t)) != 0)
+        return false;
+
+    // commands compared field by field (padding)
+    for(uint32_t i = 0; i < uCommandCount; i++)
+    {
+        const plDrawCommand* ptCommand0 = &ptDrawlist0->sbtDrawCommands[i];
+        const plDrawCommand* ptCommand1 = &ptDrawlist1->sbtDrawCommands[i];
+        if(ptCommand0->uVertexOffset != ptCommand1->uVertexOffset || ptCommand0->uIndexOffset != ptCommand1->uIndexOffset ||
+            ptCommand0->uElementCount != ptCommand1->uElementCount || ptCommand0->tTextureId != ptCommand1->tTextureId ||
+            ptCommand0->bSdf != ptCommand1->bSdf || memcmp(&ptCommand0->tClip, &ptCommand1->tClip, sizeof(plRect)) != 0)
+            return false;
+    }
+    return true;
+}
@@ -437,10 +437,10 @@ DispatchRenderLoop(CVDisplayLinkRef displayLink, const CVTimeStamp* now, const C
     fgDrawLayer = pl_request_layer(&drawlist, "Foreground Layer");
 
     // create font atlas
-    pl_add_default_font(&fontAtlas);
+    plFont* ptDefaultFont = pl_add_default_font(&fontAtlas);
     pl_build_font_atlas(&fontAtlas);
     pl_create_metal_font_texture(&fontAtlas);
-    pl_set_default_font(&fontAtlas.sbtFonts[0]);  
+    pl_set_default_font(ptDefaultFont);
 }
 
 - (void)drawableResize:(CGSize)size
@@ -495,8 +495,6 @@ DispatchRenderLoop(CVDisplayLinkRef displayLink, const CVTimeStamp* now, const C
         if(begin_frame())
         {
 
-            begin_recording();
-
             pl_new_draw_frame_metal(tGraphics.drawableRenderDescriptor);
             pl_new_frame();
 
@@ -511,6 +509,11 @@ DispatchRenderLoop(CVDisplayLinkRef displayLink, const CVTimeStamp* now, const C
             gptUiCtx->tFrameBufferScale.x = gtIO->afMainFramebufferScale[0];
             gptUiCtx->tFrameBufferScale.y = gtIO->afMainFramebufferScale[1];
             pl_render();
+
+            // glyph uploads use a blit encoder, so they are encoded before the render encoder
+            pl_record_metal_font_updates(tGraphics.tCurrentCommandBuffer);
+
+            begin_recording();
             pl_submit_metal_drawlist(&drawlist, gtIO->afMainViewportSize[0], gtIO->afMainViewportSize[1], tGraphics.tCurrentRenderEncoder, tGraphics.tCurrentCommandBuffer, tGraphics.drawableRenderDescriptor);
             pl_submit_metal_drawlist(pl_get_draw_list(NULL), gtIO->afMainViewportSize[0], gtIO->afMainViewportSize[1], tGraphics.tCurrentRenderEncoder, tGraphics.tCurrentCommandBuffer, tGraphics.drawableRenderDescriptor);
             pl_submit_metal_drawlist(pl_get_debug_draw_list(NULL), gtIO->afMainViewportSize[0], gtIO->afMainViewportSize[1], tGraphics.tCurrentRenderEncoder, tGraphics.tCurrentCommandBuffer, tGraphics.drawableRenderDescriptor);
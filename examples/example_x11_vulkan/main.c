@@ -89,6 +89,7 @@ void cleanup   (plGraphics* ptGraphics);
 bool begin_frame    (plGraphics* ptGraphics);
 void end_frame      (plGraphics* ptGraphics);
 void begin_recording(plGraphics* ptGraphics);
+void begin_main_pass(plGraphics* ptGraphics);
 void end_recording  (plGraphics* ptGraphics);
 
 plFrameContext* get_frame_resources(plGraphics* ptGraphics);
@@ -394,10 +395,10 @@ int main(int argc, char *argv[])
     fgDrawLayer = pl_request_layer(&drawlist, "Foreground Layer");
     
     // create font atlas
-    pl_add_default_font(&fontAtlas);
+    plFont* ptDefaultFont = pl_add_default_font(&fontAtlas);
     pl_build_font_atlas(&fontAtlas);
     pl_create_vulkan_font_texture(&fontAtlas);
-    pl_set_default_font(&fontAtlas.sbtFonts[0]);
+    pl_set_default_font(ptDefaultFont);
 
     // main loop
     while (gRunning)
@@ -622,6 +623,11 @@ render_frame(void)
             gptUiCtx->tFrameBufferScale.x = gtIO->afMainFramebufferScale[0];
             gptUiCtx->tFrameBufferScale.y = gtIO->afMainFramebufferScale[1];
             pl_render();
+
+            // glyph uploads are transfers, so they are recorded before the render pass
+            pl_record_vulkan_font_updates(ptCurrentFrame->tCmdBuf, (uint32_t)gtGraphics.szCurrentFrameIndex);
+
+            begin_main_pass(&gtGraphics);
             pl_submit_vulkan_drawlist(&drawlist, gtIO->afMainViewportSize[0], gtIO->afMainViewportSize[1], ptCurrentFrame->tCmdBuf, (uint32_t)gtGraphics.szCurrentFrameIndex);
             pl_submit_vulkan_drawlist(pl_get_draw_list(NULL), gtIO->afMainViewportSize[0], gtIO->afMainViewportSize[1], ptCurrentFrame->tCmdBuf, (uint32_t)gtGraphics.szCurrentFrameIndex);
             pl_submit_vulkan_drawlist(pl_get_debug_draw_list(NULL), gtIO->afMainViewportSize[0], gtIO->afMainViewportSize[1], ptCurrentFrame->tCmdBuf, (uint32_t)gtGraphics.szCurrentFrameIndex);
@@ -2240,6 +2246,12 @@ begin_recording(plGraphics* ptGraphics)
     };
     PL_VULKAN(vkResetCommandPool(ptDevice->tLogicalDevice, ptCurrentFrame->tCmdPool, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT));
     PL_VULKAN(vkBeginCommandBuffer(ptCurrentFrame->tCmdBuf, &tBeginInfo));  
+}
+
+void
+begin_main_pass(plGraphics* ptGraphics)
+{
+    plFrameContext* ptCurrentFrame = get_frame_resources(ptGraphics);
 
     VkRenderPassBeginInfo renderPassInfo = {0};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
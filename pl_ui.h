@@ -44,6 +44,7 @@ typedef struct _plUiContext  plUiContext;  // (opaque structure)
 typedef struct _plUiClipper  plUiClipper;  // data used with "pl_step_clipper(...)" function (see function)
 typedef struct _plKeyData    plKeyData;    // individual key status (down, down duration, etc.)
 typedef struct _plInputEvent plInputEvent; // holds data for input events (opaque structure)
+typedef struct _plJobSystem  plJobSystem;  // optional user scheduler for internal parallel work (see plIO)
 
 // drawing types
 typedef struct _plDrawLayer   plDrawLayer;   // layer for out of order drawing(opaque structure)
@@ -56,6 +57,10 @@ typedef struct _plFontChar       plFontChar;       // internal for now (opaque s
 typedef struct _plFontGlyph      plFontGlyph;      // internal for now (opaque structure)
 typedef struct _plFontCustomRect plFontCustomRect; // internal for now (opaque structure)
 typedef struct _plFontPrepData   plFontPrepData;   // internal for now (opaque structure)
+typedef struct _plFontShelf      plFontShelf;      // internal for now (opaque structure)
+typedef struct _plFontPacker     plFontPacker;     // internal for now (opaque structure)
+typedef struct _plFontAsciiTable plFontAsciiTable; // internal for now (opaque structure)
+typedef struct _plFontAtlasRect  plFontAtlasRect;  // region of the atlas texture (pixels)
 typedef struct _plFontRange      plFontRange;      // a range of characters
 typedef struct _plFont           plFont;           // a single font with a specific size and config
 typedef struct _plFontConfig     plFontConfig;     // configuration for loading a single font
@@ -64,9 +69,17 @@ typedef struct _plFontAtlas      plFontAtlas;      // atlas for multiple fonts
 // character types
 typedef uint16_t plUiWChar;
 
+// ids (see "pl_get_id()")
+typedef uint32_t plUiId;
+
 // plTextureID: used to represent texture for renderer backend
 typedef void* plTextureId;
 
+// jobs: plJobDispatch must run tFunction for every index in [0, uJobCount) and return once all are done
+//       (see plJobSystem for the scheduler the library itself uses)
+typedef void (*plJobFunction)(uint32_t uJobIndex, void* pData);
+typedef void (*plJobDispatch)(plJobFunction tFunction, void* pData, uint32_t uJobCount, void* pUserData);
+
 // math
 typedef union  _plVec2 plVec2;
 typedef union  _plVec4 plVec4;
@@ -162,6 +175,14 @@ void           pl_set_next_window_pos     (plVec2 tPos, plUiConditionFlags tCond
 void           pl_set_next_window_size    (plVec2 tSize, plUiConditionFlags tCondition);
 void           pl_set_next_window_collapse(bool bCollapsed, plUiConditionFlags tCondition);
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ids~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// - an id is the label hashed with its parent's id (window or open tree node), anything before "###" is ignored
+// - compute once & pass to the "*_id" widget variants to skip hashing the label every frame
+// - pl_ui_id.hpp computes the same ids at compile time for C++
+plUiId         pl_get_id   (const char* pcLabel);                   // parent is the top of the current id stack
+plUiId         pl_get_id_ex(const char* pcLabel, plUiId tParentId); // e.g. pl_get_id_ex("Ok", pl_get_id_ex("My Window", 0))
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~widgets~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 // main
@@ -176,6 +197,13 @@ bool           pl_image_button_ex (const char* pcId, plTextureId tTexture, plVec
 bool           pl_invisible_button(const char* pcText, plVec2 tSize);
 void           pl_dummy           (plVec2 tSize);
 
+// main (pre-hashed ids, label is only displayed)
+bool           pl_button_id          (plUiId tId, const char* pcText);
+bool           pl_selectable_id      (plUiId tId, const char* pcText, bool* bpValue);
+bool           pl_checkbox_id        (plUiId tId, const char* pcText, bool* pbValue);
+bool           pl_radio_button_id    (plUiId tId, const char* pcText, int* piValue, int iButtonValue);
+bool           pl_invisible_button_id(plUiId tId, plVec2 tSize);
+
 // plotting
 void           pl_progress_bar(float fFraction, plVec2 tSize, const char* pcOverlay);
 
@@ -199,10 +227,20 @@ bool           pl_slider_float_f(const char* pcLabel, float* pfValue, float fMin
 bool           pl_slider_int    (const char* pcLabel, int* piValue, int iMin, int iMax);
 bool           pl_slider_int_f  (const char* pcLabel, int* piValue, int iMin, int iMax, const char* pcFormat);
 
+// sliders (pre-hashed ids, label is only displayed)
+bool           pl_slider_float_id  (plUiId tId, const char* pcLabel, float* pfValue, float fMin, float fMax);
+bool           pl_slider_float_id_f(plUiId tId, const char* pcLabel, float* pfValue, float fMin, float fMax, const char* pcFormat);
+bool           pl_slider_int_id    (plUiId tId, const char* pcLabel, int* piValue, int iMin, int iMax);
+bool           pl_slider_int_id_f  (plUiId tId, const char* pcLabel, int* piValue, int iMin, int iMax, const char* pcFormat);
+
 // drag sliders
 bool           pl_drag_float  (const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax);
 bool           pl_drag_float_f(const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax, const char* pcFormat);
 
+// drag sliders (pre-hashed ids, label is only displayed)
+bool           pl_drag_float_id  (plUiId tId, const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax);
+bool           pl_drag_float_id_f(plUiId tId, const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax, const char* pcFormat);
+
 // trees
 // - only call "pl_tree_pop()" if "pl_tree_node()" returns true (its call automatically if false)
 // - only call "pl_end_collapsing_header()" if "pl_collapsing_header()" returns true (its call automatically if false)
@@ -213,6 +251,10 @@ bool           pl_tree_node_f          (const char* pcFmt, ...);
 bool           pl_tree_node_v          (const char* pcFmt, va_list args);
 void           pl_tree_pop             (void);
 
+// trees (pre-hashed ids, label is only displayed; tId becomes the parent id for the node's children)
+bool           pl_collapsing_header_id(plUiId tId, const char* pcText);
+bool           pl_tree_node_id        (plUiId tId, const char* pcText);
+
 // tabs & tab bars
 // - only call "pl_end_tab_bar()" if "pl_begin_tab_bar()" returns true (its call automatically if false)
 // - only call "pl_end_tab()" if "pl_begin_tab()" returns true (its call automatically if false)
@@ -334,6 +376,20 @@ void         pl_save_config_file(const char* pcFileName);
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~drawing~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+/*
+    threading (see examples/example_layer_threads)
+        * "pl_add_*", "pl_*_layer_clip_rect" & "pl_calculate_text_*" only write to the layer
+          passed in (the context & font atlas are read only), so different layers may be
+          filled from different threads at the same time (one thread per layer)
+        * text drawn from those threads must use static fonts; dynamic fonts
+          (plFontConfig::bDynamic) rasterize into the shared atlas on first use
+          & are main thread only
+        * everything else (requesting/returning/submitting layers, drawlist clip rects,
+          compiling, font atlas builds & updates, frames & widgets) is main thread only
+          & must not overlap with layers being filled
+        * plIO::fCircleTessellationMaxError changes are picked up by "pl_new_frame()"
+*/
+
 // setup
 void pl_register_drawlist(plDrawList* ptDrawlist);
 
@@ -342,9 +398,14 @@ void         pl_submit_layer (plDrawLayer* ptLayer);
 plDrawLayer* pl_request_layer(plDrawList* ptDrawlist, const char* pcName);
 void         pl_return_layer (plDrawLayer* ptLayer);
 
+// compile (merges submitted layers into sbtDrawCommands, sbtVertexBuffer & sbuIndexBuffer, no-op once compiled this frame)
+void pl_compile_drawlist   (plDrawList* ptDrawlist); // per layer copies run through plIO::ptJobSystem when set
+void pl_compile_drawlist_ex(plDrawList* ptDrawlist, plJobDispatch tDispatch, void* pUserData); // per layer copies run through tDispatch
+
 // drawing
 void pl_add_line               (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec4 tColor, float fThickness);
 void pl_add_lines              (plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uCount, plVec4 tColor, float fThickness);
+void pl_add_polyline           (plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uPointCount, plVec4 tColor, float fThickness, bool bClosed);
 void pl_add_text               (plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP, plVec4 tColor, const char* pcText, float fWrap);
 void pl_add_text_ex            (plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP, plVec4 tColor, const char* pcText, const char* pcTextEnd, float fWrap);
 void pl_add_text_clipped       (plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP, plVec2 tMin, plVec2 tMax, plVec4 tColor, const char* pcText, float fWrap);
@@ -364,12 +425,32 @@ void pl_add_image_ex           (plDrawLayer* ptLayer, plTextureId tTexture, plVe
 void pl_add_bezier_quad        (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness, uint32_t uSegments);
 void pl_add_bezier_cubic       (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness, uint32_t uSegments);
 
+// drawing with packed colors (RGBA8, r in the low byte)
+uint32_t pl_pack_color(plVec4 tColor);
+void     pl_add_line_u32               (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, uint32_t uColor, float fThickness);
+void     pl_add_lines_u32              (plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uCount, uint32_t uColor, float fThickness);
+void     pl_add_polyline_u32           (plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uPointCount, uint32_t uColor, float fThickness, bool bClosed);
+void     pl_add_triangle_u32           (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, uint32_t uColor, float fThickness);
+void     pl_add_triangle_filled_u32    (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, uint32_t uColor);
+void     pl_add_rect_u32               (plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor, float fThickness);
+void     pl_add_rect_filled_u32        (plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor);
+void     pl_add_rect_rounded_u32       (plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor, float fThickness, float fRadius, uint32_t uSegments);
+void     pl_add_rect_rounded_filled_u32(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor, float fRadius, uint32_t uSegments);
+void     pl_add_quad_u32               (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, uint32_t uColor, float fThickness);
+void     pl_add_quad_filled_u32        (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, uint32_t uColor);
+void     pl_add_circle_u32             (plDrawLayer* ptLayer, plVec2 tP, float fRadius, uint32_t uColor, uint32_t uSegments, float fThickness);
+void     pl_add_circle_filled_u32      (plDrawLayer* ptLayer, plVec2 tP, float fRadius, uint32_t uColor, uint32_t uSegments);
+void     pl_add_bezier_quad_u32        (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, uint32_t uColor, float fThickness, uint32_t uSegments);
+void     pl_add_bezier_cubic_u32       (plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, uint32_t uColor, float fThickness, uint32_t uSegments);
+
 // fonts
 void          pl_build_font_atlas        (plFontAtlas* ptAtlas);
+bool          pl_update_font_atlas       (plFontAtlas* ptAtlas); // packs fonts added since the last build into free space (true if the backend texture must be recreated)
 void          pl_cleanup_font_atlas      (plFontAtlas* ptAtlas);
-void          pl_add_default_font        (plFontAtlas* ptAtlas);
-void          pl_add_font_from_file_ttf  (plFontAtlas* ptAtlas, plFontConfig tConfig, const char* pcFile);
-void          pl_add_font_from_memory_ttf(plFontAtlas* ptAtlas, plFontConfig tConfig, void* pData);
+plFont*       pl_add_default_font        (plFontAtlas* ptAtlas); // returned fonts stay valid until pl_cleanup_font_atlas()
+plFont*       pl_add_font_from_file_ttf  (plFontAtlas* ptAtlas, plFontConfig tConfig, const char* pcFile);
+plFont*       pl_add_font_from_memory_ttf(plFontAtlas* ptAtlas, plFontConfig tConfig, void* pData);
+bool          pl_save_font_atlas_source  (const plFontAtlas* ptAtlas, const char* pcFile, const char* pcName); // built atlas as a C array (see plFontAtlas::pucBakedData)
 plVec2        pl_calculate_text_size     (plFont* ptFont, float fSize, const char* pcText, float fWrap);
 plVec2        pl_calculate_text_size_ex  (plFont* ptFont, float fSize, const char* pcText, const char* pcTextEnd, float fWrap);
 plRect        pl_calculate_text_bb       (plFont* ptFont, float fSize, plVec2 tP, const char* pcText, float fWrap);
@@ -381,6 +462,11 @@ void          pl_push_clip_rect   (plDrawList* ptDrawlist, plRect tRect, bool bA
 void          pl_pop_clip_rect    (plDrawList* ptDrawlist);
 const plRect* pl_get_clip_rect    (plDrawList* ptDrawlist);
 
+// layer clipping (use these instead of the drawlist stack when filling layers from threads)
+void          pl_push_layer_clip_rect(plDrawLayer* ptLayer, plRect tRect, bool bAccumulate);
+void          pl_pop_layer_clip_rect (plDrawLayer* ptLayer);
+const plRect* pl_get_layer_clip_rect (plDrawLayer* ptLayer);
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~misc~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void* pl_memory_alloc(size_t szSize);
@@ -414,7 +500,8 @@ enum plUiColor_
     PL_UI_COLOR_SCROLLBAR_HANDLE,
     PL_UI_COLOR_SCROLLBAR_FRAME,
     PL_UI_COLOR_SCROLLBAR_ACTIVE,
-    PL_UI_COLOR_SCROLLBAR_HOVERED
+    PL_UI_COLOR_SCROLLBAR_HOVERED,
+    PL_UI_COLOR_COUNT
 };
 
 enum plUiWindowFlags_
@@ -663,35 +750,69 @@ typedef struct _plFontConfig
     int           iSdfPadding;
     unsigned char ucOnEdgeValue;
     float         fSdfPixelDistScale;
+
+    // DYNAMIC
+    bool          bDynamic; // glyphs are rasterized on first use into the atlas' dynamic region (ranges are ignored)
 } plFontConfig;
 
 typedef struct _plFont
 {
     plFontConfig tConfig;
     plFontAtlas* ptParentAtlas;
+    uint32_t     _uIndex; // position in the parent atlas' sbtFonts
     float        fLineSpacing;
     float        fAscent;
     float        fDescent;
     
-    uint32_t*    sbuCodePoints; // glyph index lookup based on codepoint
-    plFontGlyph* sbtGlyphs;     // glyphs
+    uint32_t*    sbuCodePointPages; // page slot per 256 codepoint block (UINT32_MAX if block has no glyphs)
+    uint32_t*    sbuCodePoints;     // glyph index lookup based on codepoint (256 entries per allocated page)
+    plFontGlyph* sbtGlyphs;         // glyphs
     plFontChar*  sbtCharData;
+
+    // dynamic fonts only (parallel to sbtGlyphs)
+    uint32_t*    _sbuGlyphShelves;    // atlas shelf holding each glyph (UINT32_MAX if it has no pixels)
+    uint32_t*    _sbuGlyphCodePoints; // codepoint of each glyph (for eviction)
+    uint32_t*    _sbuFreeGlyphs;      // evicted glyph slots
+
+    // static fonts only
+    plFontAsciiTable* _ptAsciiTable; // dense ASCII metrics for the text fast paths
 } plFont;
 
+typedef struct _plFontAtlasRect
+{
+    uint32_t uX;
+    uint32_t uY;
+    uint32_t uWidth;
+    uint32_t uHeight;
+} plFontAtlasRect;
+
 typedef struct _plFontAtlas
 {
-    plFont*           sbtFonts;
-    plFontCustomRect* sbtCustomRects;
-    unsigned char*    pucPixelsAsAlpha8;
-    unsigned char*    pucPixelsAsRGBA32;
-    uint32_t          auAtlasSize[2];
-    float             afWhiteUv[2];
-    bool              bDirty;
-    int               iGlyphPadding;
-    size_t            szPixelDataSize;
-    plFontCustomRect* ptWhiteRect;
-    plTextureId       tTexture;
-    plFontPrepData*   _sbtPrepData;
+    plFont**             sbtFonts; // individually allocated (stable as fonts are added)
+    plFontCustomRect*    sbtCustomRects;
+    unsigned char*       pucPixelsAsAlpha8;
+    unsigned char*       pucPixelsAsRGBA32; // NULL when bAlpha8Only
+    uint32_t             auAtlasSize[2];
+    float                afWhiteUv[2];
+    bool                 bDirty;
+    bool                 bAlpha8Only; // skip the RGBA32 expansion (backends upload a single channel texture swizzled to white + alpha)
+    int                  iGlyphPadding;
+    size_t               szPixelDataSize;
+    plFontCustomRect*    ptWhiteRect;
+    plTextureId          tTexture;
+    const char*          pcCacheFile; // optional: built atlas is loaded from/saved to this file (keyed by font data & configs)
+    const unsigned char* pucBakedData; // optional: array from pl_save_font_atlas_source (alpha8 pixels used in place, set bAlpha8Only to skip the RGBA32 copy too)
+    size_t               szBakedDataSize;
+    uint32_t             uDynamicHeight;  // rows reserved below packed glyphs for bDynamic fonts (0 = 512)
+    plFontAtlasRect*     sbtDirtyRects;   // pixels changed since the backend last uploaded (backends reset after uploading)
+    plFontPrepData*      _sbtPrepData;
+    bool                 _bBorrowedPixels; // pucPixelsAsAlpha8 points into pucBakedData
+    plFontShelf*         _sbtShelves;      // dynamic region allocator
+    uint32_t             _uDynamicY;       // first row of the dynamic region
+    uint32_t             _uDynamicEndY;    // one past the last row of the dynamic region
+    plFontPacker*        _ptPacker;        // skyline kept after a build for pl_update_font_atlas
+    uint32_t             _uBuiltFontCount; // fonts already in the atlas
+    uint32_t             _uEvictions;      // bumped whenever dynamic glyphs are evicted
 } plFontAtlas;
 
 typedef struct _plDrawList
@@ -699,11 +820,17 @@ typedef struct _plDrawList
     plDrawLayer**  sbtSubmittedLayers;
     plDrawLayer**  sbtLayerCache;
     plDrawLayer**  sbtLayersCreated;
-    plDrawCommand* sbtDrawCommands;
-    plDrawVertex*  sbtVertexBuffer;
+    plDrawCommand* sbtDrawCommands;          // compiled & merged (see pl_compile_drawlist)
+    plDrawVertex*  sbtVertexBuffer;          // compiled, layer vertices concatenated in submission order
+    uint32_t*      sbuIndexBuffer;           // compiled, contiguous across submitted layers
     uint32_t       uIndexBufferByteSize;
     uint32_t       uLayersCreated;
     plRect*        sbtClipStack;
+    uint32_t       uCommandCountBeforeMerge; // layer commands seen by last compile
+    uint32_t       uCommandCountAfterMerge;  // commands emitted by last compile
+    bool           bCompiled;
+    uint32_t*      _sbuLayerVertexBases;     // per submission (a layer may be submitted more than once)
+    uint32_t*      _sbuLayerIndexBases;
 } plDrawList;
 
 typedef struct _plFontCustomRect
@@ -730,8 +857,10 @@ typedef struct _plDrawLayer
     const char*     pcName;
     plDrawList*     ptDrawlist;
     plDrawCommand*  sbtCommandBuffer;
-    uint32_t*       sbuIndexBuffer;
+    plDrawVertex*   sbtVertexBuffer; // layer local (rebased into the drawlist by pl_compile_drawlist)
+    uint32_t*       sbuIndexBuffer;  // indices into sbtVertexBuffer
     plVec2*         sbtPath;
+    plRect*         sbtClipStack;    // overrides the drawlist clip stack while not empty
     uint32_t        uVertexCount;
     plDrawCommand*  _ptLastCommand;
 } plDrawLayer;
@@ -763,6 +892,16 @@ typedef struct _plFontGlyph
     float leftBearing;  
 } plFontGlyph;
 
+typedef struct _plJobSystem
+{
+    // schedule tFunction for every index in [0, uJobCount) & return a handle for wait_jobs_fn
+    void* (*submit_jobs_fn)(void* pUserData, plJobFunction tFunction, void* pData, uint32_t uJobCount);
+
+    // block until every job of the submission is done (the calling thread may help out)
+    void  (*wait_jobs_fn)(void* pUserData, void* pHandle);
+    void*   pUserData;
+} plJobSystem;
+
 typedef struct _plIO
 {
 
@@ -777,6 +916,7 @@ typedef struct _plIO
     float       fKeyRepeatDelay;          // default 0.275f
     float       fKeyRepeatRate;           // default 0.050f
     float       fConfigSavingRate;        // default 5.0f
+    float       fCircleTessellationMaxError; // default 0.30f pixels (used when segment count is 0)
     const char* pcConfigFileName;         // default "pl_config.ini"
     float       afMainViewportSize[2];
     float       afMainFramebufferScale[2];
@@ -799,6 +939,9 @@ typedef struct _plIO
     void*       pClipboardUserData;
     char*       sbcClipboardData;
 
+    // worker threads (optional, internal parallel work runs serially on the calling thread when unset)
+    plJobSystem* ptJobSystem;
+
     //------------------------------------------------------------------
     // Output
     //------------------------------------------------------------------
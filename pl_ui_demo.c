@@ -18,6 +18,12 @@ pl_show_debug_window(bool* pbOpen)
         pl_text("%.3f ms/frame (%0.1f FPS)", gptCtx->tIO.fDeltaTime * 1000.0f, gptCtx->tIO.fFrameRate);
         pl_layout_row(PL_UI_LAYOUT_ROW_TYPE_DYNAMIC, 0.0f, 1, pfRatios);
         pl_text("%u allocations", gptCtx->uMemoryAllocations);
+        pl_layout_row(PL_UI_LAYOUT_ROW_TYPE_DYNAMIC, 0.0f, 1, pfRatios);
+        pl_text("%u allocations last frame", gptCtx->uLastFrameMemoryAllocations);
+        pl_layout_row(PL_UI_LAYOUT_ROW_TYPE_DYNAMIC, 0.0f, 1, pfRatios);
+        pl_text("text cache: %u hits, %u misses", gptCtx->uTextCacheHits, gptCtx->uTextCacheMisses);
+        pl_layout_row(PL_UI_LAYOUT_ROW_TYPE_DYNAMIC, 0.0f, 1, pfRatios);
+        pl_text("draw commands: %u (%u before merge)", gptCtx->ptDrawlist->uCommandCountAfterMerge, gptCtx->ptDrawlist->uCommandCountBeforeMerge);
 
         pl_separator();
 
@@ -126,6 +132,20 @@ pl_show_debug_window(bool* pbOpen)
             }
             pl_tree_pop();
         }
+        if(pl_tree_node("Fonts"))
+        {
+            if(gptCtx->fontAtlas)
+            {
+                for(uint32_t uFontIndex = 0; uFontIndex < plu_sb_size(gptCtx->fontAtlas->sbtFonts); uFontIndex++)
+                {
+                    const plFont* ptFont = gptCtx->fontAtlas->sbtFonts[uFontIndex];
+                    const uint32_t uTableBytes = (plu_sb_capacity(ptFont->sbuCodePointPages) + plu_sb_capacity(ptFont->sbuCodePoints)) * sizeof(uint32_t);
+                    pl_text("Font %u: %0.1f px, %u glyphs, %u pages, %u bytes codepoint table", uFontIndex, ptFont->tConfig.fFontSize, plu_sb_size(ptFont->sbtGlyphs),
+                        plu_sb_size(ptFont->sbuCodePoints) / PL__CODEPOINT_PAGE_SIZE, uTableBytes);
+                }
+            }
+            pl_tree_pop();
+        }
         if(pl_tree_node("Internal State"))
         {
             pl_text("Windows");
@@ -21,6 +21,30 @@ Index of this file:
 #include <float.h> // FLT_MAX
 #include "pl_ui_internal.h"
 
+// ASCII scanning uses SSE2/NEON unless PL_UI_NO_SIMD is defined
+#if !defined(PL_UI_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define PL__SIMD_SSE2
+#elif !defined(PL_UI_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+    #include <arm_neon.h>
+    #define PL__SIMD_NEON
+#endif
+
+// ttf files are memory mapped unless PL_UI_NO_FILE_MAPPING is defined
+#ifndef PL_UI_NO_FILE_MAPPING
+    #ifdef _WIN32
+        #ifndef WIN32_LEAN_AND_MEAN
+            #define WIN32_LEAN_AND_MEAN
+        #endif
+        #include <windows.h>
+    #else
+        #include <fcntl.h>    // open
+        #include <unistd.h>   // close
+        #include <sys/mman.h> // mmap, munmap
+        #include <sys/stat.h> // fstat
+    #endif
+#endif
+
 // stb libs
 #include "stb_rect_pack.h"
 #include "stb_truetype.h"
@@ -35,22 +59,253 @@ typedef struct _plFontPrepData
     stbtt_pack_range* ranges;
     stbrp_rect*       rects;
     unsigned char*    ptrTtf;
+    size_t            szMappedSize;    // > 0 when ptrTtf is a read only file mapping
+    const char*       pcCompressedTtf; // embedded default font (decompressed lazily)
+    uint32_t          uKey;            // font data + config hash (atlas cache key)
     uint32_t          uTotalCharCount;
     float             scale;
     uint32_t          area;
 } plFontPrepData;
 
+// on-disk atlas cache (bump the version whenever the layout below or any
+// cached struct changes)
+#define PL_UI_ATLAS_CACHE_VERSION 1
+
+typedef struct _plFontAtlasCacheHeader
+{
+    char     acMagic[4]; // "PLFA"
+    uint32_t uVersion;
+    uint32_t uKey;
+    uint32_t uFontCount;
+    uint32_t uCustomRectCount;
+    uint32_t uWhiteRectIndex;
+    uint32_t auAtlasSize[2];
+    float    afWhiteUv[2];
+} plFontAtlasCacheHeader;
+
+typedef struct _plFontCacheEntry
+{
+    float    fLineSpacing;
+    float    fAscent;
+    float    fDescent;
+    float    fSdfPixelDistScale;
+    uint32_t uGlyphCount;
+    uint32_t uCharCount;
+} plFontCacheEntry; // followed by glyphs & char data
+
+// glyphs are independent, each job handles a contiguous slice (output is identical to a serial run)
+#define PL_UI_SDF_GLYPHS_PER_JOB 16
+
+typedef struct _plSdfGlyphJob
+{
+    const stbtt_fontinfo* ptFontInfo;
+    const plFontConfig*   ptConfig;
+    const int*            aiCodePoints;
+    plFontChar*           atChars;   // font char data (flattened across ranges)
+    plFontCustomRect*     atRects;   // atlas custom rects reserved for this font
+    uint32_t              uGlyphCount;
+    float                 fScale;
+} plSdfGlyphJob;
+
+// after packing every rect is a disjoint region of the atlas, so rasterization,
+// custom rect blits & the RGBA expansion can all be split into independent jobs
+#define PL_UI_ATLAS_RECTS_PER_JOB 64
+#define PL_UI_ATLAS_ROWS_PER_JOB  64
+
+typedef struct _plFontRasterRange
+{
+    plFontPrepData*   ptPrep;
+    stbtt_pack_range* ptRange;
+    stbrp_rect*       ptRects; // first rect of this range
+} plFontRasterRange;
+
+typedef struct _plAtlasBuildJob
+{
+    plFontAtlas*               ptAtlas;
+    const stbtt_pack_context*  ptPackContext;
+    const plFontRasterRange*   atRanges;
+    uint32_t                   uFirstCustomRect; // earlier rects were blitted by a previous build
+} plAtlasBuildJob;
+
+// dynamic region: rows of shelves filled left to right, evicted a whole shelf
+// at a time (least recently used first, never one used during the current frame)
+#define PL_UI_ATLAS_DYNAMIC_HEIGHT 512
+
+typedef struct _plFontShelf
+{
+    uint32_t uY;
+    uint32_t uHeight;
+    uint32_t uCursorX;   // next free column
+    uint64_t ulLastUsed; // frame count when a glyph on this shelf was last looked up
+} plFontShelf;
+
+// structure of arrays copy of the ASCII glyphs, so the text loops skip UTF-8
+// decoding & the paged codepoint lookup for the common case
+typedef struct _plFontAsciiTable
+{
+    uint32_t auGlyph[128]; // index into sbtGlyphs (PL__GLYPH_NOT_FOUND when missing)
+    float    afXAdvance[128];
+    float    afX0[128];
+    float    afY0[128];
+    float    afX1[128];
+    float    afY1[128];
+    float    afLeftBearing[128];
+} plFontAsciiTable;
+
+// running state of a text measurement (shared by the scalar & ASCII paths)
+typedef struct _plTextMeasure
+{
+    plVec2 tCursor;
+    plVec2 tMin; // "originalPosition" in the draw loops
+    plVec2 tMax;
+    float  fScale;
+    float  fLineSpacing;
+    float  fWrap;
+    bool   bFirstCharacter;
+} plTextMeasure;
+
+// skyline kept after a build so fonts added later fill the space it left free
+typedef struct _plFontPacker
+{
+    stbtt_pack_context tContext;
+} plFontPacker;
+
 //-----------------------------------------------------------------------------
 // [SECTION] helpers
 //-----------------------------------------------------------------------------
 
 static void         pl__prepare_draw_command(plDrawLayer* ptLayer, plTextureId texture, bool sdf);
 static void         pl__reserve_triangles(plDrawLayer* ptLayer, uint32_t indexCount, uint32_t uVertexCount);
-static void         pl__add_vertex(plDrawLayer* ptLayer, plVec2 pos, plVec4 color, plVec2 uv);
+static void         pl__add_vertex(plDrawLayer* ptLayer, plVec2 pos, uint32_t uColor, plVec2 uv);
 static void         pl__add_index(plDrawLayer* ptLayer, uint32_t vertexStart, uint32_t i0, uint32_t i1, uint32_t i2);
+static void         pl__stroke_polyline(plDrawLayer* ptLayer, const plVec2* atPoints, uint32_t uPointCount, uint32_t uColor, float fThickness, bool bClosed);
+static void         pl__add_text_run(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, const char* pcTextEnd, float wrap, const plRect* ptClipRect);
 static inline float pl__get_max(float v1, float v2) { return v1 > v2 ? v1 : v2;}
 static inline int   pl__get_min(int v1, int v2)     { return v1 < v2 ? v1 : v2;}
-static char*        plu__read_file(const char* file);
+static char*        plu__read_file(const char* file, size_t* pszSize);
+
+static void         pl__build_codepoint_table(plFont* ptFont);
+static void         pl__map_codepoints(plFont* ptFont);
+static void         pl__build_ascii_table(plFont* ptFont);
+static void         pl__measure_text(plFont* ptFont, float fSize, const char* pcText, const char* pcTextEnd, float fWrap, plVec2* ptMinOut, plVec2* ptMaxOut);
+
+// first byte at or after pcText that is not 7-bit ASCII (pcTextEnd if none)
+static inline const char*
+pl__ascii_run_end(const char* pcText, const char* pcTextEnd)
+{
+#if defined(PL__SIMD_SSE2)
+    while(pcTextEnd - pcText >= 16)
+    {
+        if(_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)pcText)) != 0)
+            break;
+        pcText += 16;
+    }
+#elif defined(PL__SIMD_NEON)
+    while(pcTextEnd - pcText >= 16)
+    {
+        if(vmaxvq_u8(vld1q_u8((const uint8_t*)pcText)) >= 0x80)
+            break;
+        pcText += 16;
+    }
+#else
+    while(pcTextEnd - pcText >= 8)
+    {
+        uint64_t ulWord;
+        memcpy(&ulWord, pcText, sizeof(uint64_t));
+        if(ulWord & 0x8080808080808080ull)
+            break;
+        pcText += 8;
+    }
+#endif
+    while(pcText < pcTextEnd && (unsigned char)*pcText < 0x80)
+        pcText++;
+    return pcText;
+}
+
+static inline void
+pl__measure_glyph(plTextMeasure* ptMeasure, float fX0, float fY0, float fX1, float fY1, float fAdvance, float fLeftBearing)
+{
+    const float fScale = ptMeasure->fScale;
+
+    // adjust for left side bearing if first char
+    if(ptMeasure->bFirstCharacter)
+    {
+        if(fLeftBearing > 0.0f) ptMeasure->tCursor.x += fLeftBearing * fScale;
+        ptMeasure->bFirstCharacter = false;
+        ptMeasure->tMin.x = ptMeasure->tCursor.x + fX0 * fScale;
+        ptMeasure->tMin.y = ptMeasure->tCursor.y + fY0 * fScale;
+    }
+
+    float x0 = ptMeasure->tCursor.x + fX0 * fScale;
+    float x1 = ptMeasure->tCursor.x + fX1 * fScale;
+    float y0 = ptMeasure->tCursor.y + fY0 * fScale;
+    float y1 = ptMeasure->tCursor.y + fY1 * fScale;
+
+    if(ptMeasure->fWrap > 0.0f && x1 > ptMeasure->tMin.x + ptMeasure->fWrap)
+    {
+        x0 = ptMeasure->tMin.x + fX0 * fScale;
+        y0 = y0 + ptMeasure->fLineSpacing;
+        x1 = ptMeasure->tMin.x + fX1 * fScale;
+        y1 = y1 + ptMeasure->fLineSpacing;
+
+        ptMeasure->tCursor.x = ptMeasure->tMin.x;
+        ptMeasure->tCursor.y += ptMeasure->fLineSpacing;
+    }
+
+    if(x0 < ptMeasure->tMin.x) ptMeasure->tMin.x = x0;
+    if(y0 < ptMeasure->tMin.y) ptMeasure->tMin.y = y0;
+    if(x1 > ptMeasure->tMax.x) ptMeasure->tMax.x = x1;
+    if(y1 > ptMeasure->tMax.y) ptMeasure->tMax.y = y1;
+
+    ptMeasure->tCursor.x += fAdvance * fScale;
+}
+
+// fonts
+static plFont*        pl__add_font(plFontAtlas* atlas, plFontConfig config, void* pTtf, size_t szTtfSize, bool bMapped, const char* pcCompressedTtf);
+static unsigned char* pl__map_file(const char* pcFile, size_t* pszSize);
+static void           pl__release_font_data(plFontPrepData* ptPrep);
+static void           pl__prepare_font(plFontAtlas* atlas, plFont* ptFont, plFontPrepData* ptPrep);
+static uint32_t       pl__hash_font(const plFontConfig* ptConfig, const void* pTtf, size_t szTtfSize, const char* pcCompressedTtf);
+static unsigned char* pl__decompress_default_font(const char* pcCompressedTtf);
+static uint32_t       pl__font_atlas_cache_key(const plFontAtlas* ptAtlas);
+static bool           pl__load_font_atlas_cache(plFontAtlas* ptAtlas);
+static bool           pl__load_font_atlas_data(plFontAtlas* ptAtlas, const unsigned char* pucData, size_t szSize, bool bBorrowPixels);
+static unsigned char* pl__serialize_font_atlas(const plFontAtlas* ptAtlas, size_t* pszSize);
+static void           pl__save_font_atlas_cache(const plFontAtlas* ptAtlas);
+static plFontGlyph    pl__make_glyph(const plFontAtlas* ptAtlas, const plFont* ptFont, const plFontPrepData* ptPrep, const plFontChar* ptChar, int iCodePoint);
+static void           pl__add_font_glyphs(plFontAtlas* ptAtlas, uint32_t uFontIndex);
+static bool           pl__grow_font_atlas(plFontAtlas* ptAtlas, uint32_t uHeight);
+static void           pl__free_font_packer(plFontAtlas* ptAtlas);
+
+// dynamic fonts
+static void           pl__set_codepoint_glyph(plFont* ptFont, uint32_t uCodePoint, uint32_t uGlyphIndex);
+static uint32_t       pl__load_dynamic_glyph(plFont* ptFont, uint32_t uCodePoint);
+static uint32_t       pl__allocate_dynamic_rect(plFontAtlas* ptAtlas, uint32_t uWidth, uint32_t uHeight, uint32_t* puX, uint32_t* puY);
+static void           pl__evict_shelf(plFontAtlas* ptAtlas, uint32_t uShelf);
+static void           pl__add_atlas_dirty_rect(plFontAtlas* ptAtlas, uint32_t uX, uint32_t uY, uint32_t uWidth, uint32_t uHeight);
+
+static uint32_t      pl__circle_segment_count(float fRadius);
+static const plVec2* pl__get_arc_table(uint32_t uSegments);
+static inline plVec2 pl__arc_point(const plVec2* atArc, uint32_t uSegments, uint32_t uIndex);
+
+// drawlist compilation
+static void          pl__compile_drawlist_layer(uint32_t uLayerIndex, void* pData);
+
+// fonts
+static void          pl__generate_sdf_glyphs(uint32_t uJobIndex, void* pData);
+static void          pl__rasterize_font_range(uint32_t uJobIndex, void* pData);
+static void          pl__blit_custom_rects(uint32_t uJobIndex, void* pData);
+static void          pl__expand_atlas_alpha(uint32_t uJobIndex, void* pData);
+
+static inline bool
+pl__draw_command_visible(const plDrawCommand* ptCommand)
+{
+    // zero width clip means "no clip", anything else with no area draws nothing
+    if(ptCommand->uElementCount == 0u)
+        return false;
+    const plRect* ptClip = &ptCommand->tClip;
+    return plu_rect_width(ptClip) == 0.0f || (plu_rect_width(ptClip) > 0.0f && plu_rect_height(ptClip) > 0.0f);
+}
 
 // math
 #define pl__add_vec2(left, right)      (plVec2){(left).x + (right).x, (left).y + (right).y}
@@ -59,10 +314,13 @@ static char*        plu__read_file(const char* file);
 #define pl__mul_f_vec2(left, right)    (plVec2){(left) * (right).x, (left) * (right).y}
 
 // stateful drawing
-#define pl__submit_path(ptLayer, color, thickness)\
-    pl_add_lines((ptLayer), (ptLayer)->sbtPath, plu_sb_size((ptLayer)->sbtPath) - 1, (color), (thickness));\
+#define pl__submit_path(ptLayer, color, thickness, closed)\
+    pl__stroke_polyline((ptLayer), (ptLayer)->sbtPath, plu_sb_size((ptLayer)->sbtPath), (color), (thickness), (closed));\
     plu_sb_reset((ptLayer)->sbtPath);
 
+// joins sharper than this (miter length / half thickness) fall back to bevels
+#define PL_UI_MITER_LIMIT 4.0f
+
 #define PL_NORMALIZE2F_OVER_ZERO(VX,VY) \
     { float d2 = (VX) * (VX) + (VY) * (VY); \
     if (d2 > 0.0f) { float inv_len = 1.0f / sqrtf(d2); (VX) *= inv_len; (VY) *= inv_len; } } (void)0
@@ -112,165 +370,163 @@ pl_return_layer(plDrawLayer* ptLayer)
     ptLayer->_ptLastCommand = NULL;
     ptLayer->uVertexCount = 0u;
     plu_sb_reset(ptLayer->sbtCommandBuffer);
+    plu_sb_reset(ptLayer->sbtVertexBuffer);
     plu_sb_reset(ptLayer->sbuIndexBuffer);
     plu_sb_reset(ptLayer->sbtPath);
+    plu_sb_reset(ptLayer->sbtClipStack);
     plu_sb_push(ptLayer->ptDrawlist->sbtLayerCache, ptLayer);
 }
 
+uint32_t
+pl_pack_color(plVec4 tColor)
+{
+    return plu_pack_color(tColor);
+}
+
 void
 pl_submit_layer(plDrawLayer* ptLayer)
 {
     plu_sb_push(ptLayer->ptDrawlist->sbtSubmittedLayers, ptLayer);
     ptLayer->ptDrawlist->uIndexBufferByteSize += plu_sb_size(ptLayer->sbuIndexBuffer) * sizeof(uint32_t);
+    ptLayer->ptDrawlist->bCompiled = false;
 }
 
 void
-pl_add_line(plDrawLayer* ptLayer, plVec2 p0, plVec2 p1, plVec4 tColor, float fThickness)
+pl_compile_drawlist(plDrawList* ptDrawlist)
 {
-    plu_sb_push(ptLayer->sbtPath, p0);
-    plu_sb_push(ptLayer->sbtPath, p1);
-    pl__submit_path(ptLayer, tColor, fThickness);
+    pl_compile_drawlist_ex(ptDrawlist, pl__dispatch_jobs, NULL);
 }
 
 void
-pl_add_lines(plDrawLayer* ptLayer, plVec2* atPoints, uint32_t count, plVec4 color, float thickness)
+pl_compile_drawlist_ex(plDrawList* ptDrawlist, plJobDispatch tDispatch, void* pUserData)
 {
-    pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
-    pl__reserve_triangles(ptLayer, 6 * count, 4 * count);
-
-    for(uint32_t i = 0u; i < count; i++)
+    if(ptDrawlist->bCompiled)
+        return;
+
+    plu_sb_reset(ptDrawlist->sbtDrawCommands);
+
+    // prefix sums: where each submission lands in the compiled buffers
+    // (kept per submission, not per layer, so a layer submitted twice is copied twice)
+    const uint32_t uLayerCount = plu_sb_size(ptDrawlist->sbtSubmittedLayers);
+    plu_sb_resize(ptDrawlist->_sbuLayerVertexBases, uLayerCount);
+    plu_sb_resize(ptDrawlist->_sbuLayerIndexBases, uLayerCount);
+    uint32_t uVertexCount = 0u;
+    uint32_t uIndexCount = 0u;
+    uint32_t uCommandCount = 0u;
+    for(uint32_t i = 0u; i < uLayerCount; i++)
     {
-        float dx = atPoints[i + 1].x - atPoints[i].x;
-        float dy = atPoints[i + 1].y - atPoints[i].y;
-        PL_NORMALIZE2F_OVER_ZERO(dx, dy);
-
-        plVec2 normalVector = 
+        const plDrawLayer* ptLayer = ptDrawlist->sbtSubmittedLayers[i];
+        ptDrawlist->_sbuLayerVertexBases[i] = uVertexCount;
+        ptDrawlist->_sbuLayerIndexBases[i] = uIndexCount;
+        uVertexCount += plu_sb_size(ptLayer->sbtVertexBuffer);
+        uCommandCount += plu_sb_size(ptLayer->sbtCommandBuffer);
+        for(uint32_t j = 0u; j < plu_sb_size(ptLayer->sbtCommandBuffer); j++)
         {
-            .x = dy,
-            .y = -dx
-        };
-
-        plVec2 cornerPoints[4] = 
+            if(pl__draw_command_visible(&ptLayer->sbtCommandBuffer[j]))
+                uIndexCount += ptLayer->sbtCommandBuffer[j].uElementCount;
+        }
+    }
+    plu_sb_resize(ptDrawlist->sbtVertexBuffer, uVertexCount);
+    plu_sb_resize(ptDrawlist->sbuIndexBuffer, uIndexCount);
+    plu_sb_reserve(ptDrawlist->sbtDrawCommands, uCommandCount);
+
+    // merge commands (cheap, serial)
+    uint32_t uIndexOffset = 0u;
+    plDrawCommand* ptLastCommand = NULL;
+    for(uint32_t i = 0u; i < uLayerCount; i++)
+    {
+        const plDrawLayer* ptLayer = ptDrawlist->sbtSubmittedLayers[i];
+        for(uint32_t j = 0u; j < plu_sb_size(ptLayer->sbtCommandBuffer); j++)
         {
-            pl__subtract_vec2(atPoints[i],     pl__mul_vec2_f(normalVector, thickness / 2.0f)),
-            pl__subtract_vec2(atPoints[i + 1], pl__mul_vec2_f(normalVector, thickness / 2.0f)),
-            pl__add_vec2(     atPoints[i + 1], pl__mul_vec2_f(normalVector, thickness / 2.0f)),
-            pl__add_vec2(     atPoints[i],     pl__mul_vec2_f(normalVector, thickness / 2.0f))
-        };
+            const plDrawCommand* ptLayerCommand = &ptLayer->sbtCommandBuffer[j];
+            if(!pl__draw_command_visible(ptLayerCommand))
+                continue;
+
+            // indices are compacted so consecutive commands are always adjacent in the index buffer
+            const plRect* ptClip = &ptLayerCommand->tClip;
+            if(ptLastCommand && ptLastCommand->tTextureId == ptLayerCommand->tTextureId && ptLastCommand->bSdf == ptLayerCommand->bSdf &&
+                ptLastCommand->tClip.tMin.x == ptClip->tMin.x && ptLastCommand->tClip.tMin.y == ptClip->tMin.y &&
+                ptLastCommand->tClip.tMax.x == ptClip->tMax.x && ptLastCommand->tClip.tMax.y == ptClip->tMax.y)
+            {
+                ptLastCommand->uElementCount += ptLayerCommand->uElementCount;
+            }
+            else
+            {
+                plDrawCommand tCommand = *ptLayerCommand;
+                tCommand.uIndexOffset = uIndexOffset;
+                tCommand.uVertexOffset += ptDrawlist->_sbuLayerVertexBases[i];
+                plu_sb_push(ptDrawlist->sbtDrawCommands, tCommand);
+                ptLastCommand = &plu_sb_top(ptDrawlist->sbtDrawCommands);
+            }
+            uIndexOffset += ptLayerCommand->uElementCount;
+        }
+    }
 
-        uint32_t vertexStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-        pl__add_vertex(ptLayer, cornerPoints[0], color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        pl__add_vertex(ptLayer, cornerPoints[1], color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        pl__add_vertex(ptLayer, cornerPoints[2], color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        pl__add_vertex(ptLayer, cornerPoints[3], color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    // copy & rebase (submissions write disjoint ranges, so one job per submission)
+    if(tDispatch && uLayerCount > 1)
+        tDispatch(pl__compile_drawlist_layer, ptDrawlist, uLayerCount, pUserData);
+    else
+    {
+        for(uint32_t i = 0u; i < uLayerCount; i++)
+            pl__compile_drawlist_layer(i, ptDrawlist);
+    }
 
-        pl__add_index(ptLayer, vertexStart, 0, 1, 2);
-        pl__add_index(ptLayer, vertexStart, 0, 2, 3);
-    }  
+    ptDrawlist->uIndexBufferByteSize = uIndexCount * sizeof(uint32_t);
+    ptDrawlist->uCommandCountBeforeMerge = uCommandCount;
+    ptDrawlist->uCommandCountAfterMerge = plu_sb_size(ptDrawlist->sbtDrawCommands);
+    ptDrawlist->bCompiled = true;
 }
 
 void
-pl_add_text(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, float wrap)
+pl_add_line(plDrawLayer* ptLayer, plVec2 p0, plVec2 p1, plVec4 tColor, float fThickness)
 {
-    const char* pcTextEnd = text + strlen(text);
-    pl_add_text_ex(ptLayer, font, size, p, color, text, pcTextEnd, wrap);
+    pl_add_line_u32(ptLayer, p0, p1, plu_pack_color(tColor), fThickness);
 }
 
 void
-pl_add_text_ex(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, const char* pcTextEnd, float wrap)
+pl_add_line_u32(plDrawLayer* ptLayer, plVec2 p0, plVec2 p1, uint32_t uColor, float fThickness)
 {
-    float scale = size > 0.0f ? size / font->tConfig.fFontSize : 1.0f;
+    plu_sb_push(ptLayer->sbtPath, p0);
+    plu_sb_push(ptLayer->sbtPath, p1);
+    pl__submit_path(ptLayer, uColor, fThickness, false);
+}
 
-    float fLineSpacing = scale * font->fLineSpacing;
-    const plVec2 originalPosition = p;
-    bool firstCharacter = true;
+// count is the number of segments (atPoints holds count + 1 points)
+void
+pl_add_lines(plDrawLayer* ptLayer, plVec2* atPoints, uint32_t count, plVec4 color, float thickness)
+{
+    pl_add_lines_u32(ptLayer, atPoints, count, plu_pack_color(color), thickness);
+}
 
-    while(text < pcTextEnd)
-    {
-        uint32_t c = (uint32_t)*text;
-        if(c < 0x80)
-            text += 1;
-        else
-        {
-            text += plu_text_char_from_utf8(&c, text, NULL);
-            if(c == 0) // malformed UTF-8?
-                break;
-        }
+void
+pl_add_lines_u32(plDrawLayer* ptLayer, plVec2* atPoints, uint32_t count, uint32_t uColor, float thickness)
+{
+    pl__stroke_polyline(ptLayer, atPoints, count + 1, uColor, thickness, false);
+}
 
-        if(c == '\n')
-        {
-            p.x = originalPosition.x;
-            p.y += fLineSpacing;
-        }
-        else if(c == '\r')
-        {
-            // do nothing
-        }
-        else
-        {
+void
+pl_add_polyline(plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uPointCount, plVec4 tColor, float fThickness, bool bClosed)
+{
+    pl_add_polyline_u32(ptLayer, atPoints, uPointCount, plu_pack_color(tColor), fThickness, bClosed);
+}
 
-            bool glyphFound = false;
-            for(uint32_t i = 0u; i < plu_sb_size(font->tConfig.sbtRanges); i++)
-            {
-                if (c >= (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint && c < (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint + (uint32_t)font->tConfig.sbtRanges[i].uCharCount) 
-                {
+void
+pl_add_polyline_u32(plDrawLayer* ptLayer, plVec2* atPoints, uint32_t uPointCount, uint32_t uColor, float fThickness, bool bClosed)
+{
+    pl__stroke_polyline(ptLayer, atPoints, uPointCount, uColor, fThickness, bClosed);
+}
 
-                    
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
-                    const plFontGlyph* glyph = &font->sbtGlyphs[font->sbuCodePoints[c]];
-
-                    // adjust for left side bearing if first char
-                    if(firstCharacter)
-                    {
-                        if(glyph->leftBearing > 0.0f) p.x += glyph->leftBearing * scale;
-                        firstCharacter = false;
-                    }
-
-                    x0 = p.x + glyph->x0 * scale;
-                    x1 = p.x + glyph->x1 * scale;
-                    y0 = p.y + glyph->y0 * scale;
-                    y1 = p.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
-                    {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + fLineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + fLineSpacing;
-
-                        p.x = originalPosition.x;
-                        p.y += fLineSpacing;
-                    }
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    p.x += glyph->xAdvance * scale;
-                    if(c != ' ')
-                    {
-                        pl__prepare_draw_command(ptLayer, font->ptParentAtlas->tTexture, font->tConfig.bSdf);
-                        pl__reserve_triangles(ptLayer, 6, 4);
-                        uint32_t uVtxStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-                        pl__add_vertex(ptLayer, (plVec2){x0, y0}, color, (plVec2){s0, t0});
-                        pl__add_vertex(ptLayer, (plVec2){x1, y0}, color, (plVec2){s1, t0});
-                        pl__add_vertex(ptLayer, (plVec2){x1, y1}, color, (plVec2){s1, t1});
-                        pl__add_vertex(ptLayer, (plVec2){x0, y1}, color, (plVec2){s0, t1});
-
-                        pl__add_index(ptLayer, uVtxStart, 1, 0, 2);
-                        pl__add_index(ptLayer, uVtxStart, 2, 0, 3);
-                    }
-
-                    glyphFound = true;
-                    break;
-                }
-            }
+void
+pl_add_text(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, float wrap)
+{
+    const char* pcTextEnd = text + strlen(text);
+    pl_add_text_ex(ptLayer, font, size, p, color, text, pcTextEnd, wrap);
+}
 
-            assert(glyphFound && "Glyph not found");
-        }   
-    }
+void
+pl_add_text_ex(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, const char* pcTextEnd, float wrap)
+{
+    pl__add_text_run(ptLayer, font, size, p, color, text, pcTextEnd, wrap, NULL);
 }
 
 void
@@ -283,129 +539,53 @@ pl_add_text_clipped(plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP
 void
 pl_add_text_clipped_ex(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec2 tMin, plVec2 tMax, plVec4 color, const char* text, const char* pcTextEnd, float wrap)
 {
-    // const plVec2 tTextSize = pl_calculate_text_size_ex(font, size, text, pcTextEnd, wrap);
     const plRect tClipRect = {tMin, tMax};
-
-    float scale = size > 0.0f ? size / font->tConfig.fFontSize : 1.0f;
-
-    float fLineSpacing = scale * font->fLineSpacing;
-    const plVec2 originalPosition = p;
-    bool firstCharacter = true;
-
-    while(text < pcTextEnd)
-    {
-        uint32_t c = (uint32_t)*text;
-        if(c < 0x80)
-            text += 1;
-        else
-        {
-            text += plu_text_char_from_utf8(&c, text, NULL);
-            if(c == 0) // malformed UTF-8?
-                break;
-        }
-
-        if(c == '\n')
-        {
-            p.x = originalPosition.x;
-            p.y += fLineSpacing;
-        }
-        else if(c == '\r')
-        {
-            // do nothing
-        }
-        else
-        {
-
-            bool glyphFound = false;
-            for(uint32_t i = 0u; i < plu_sb_size(font->tConfig.sbtRanges); i++)
-            {
-                if (c >= (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint && c < (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint + (uint32_t)font->tConfig.sbtRanges[i].uCharCount) 
-                {
-
-                    
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
-                    const plFontGlyph* glyph = &font->sbtGlyphs[font->sbuCodePoints[c]];
-
-                    // adjust for left side bearing if first char
-                    if(firstCharacter)
-                    {
-                        if(glyph->leftBearing > 0.0f) p.x += glyph->leftBearing * scale;
-                        firstCharacter = false;
-                    }
-
-                    x0 = p.x + glyph->x0 * scale;
-                    x1 = p.x + glyph->x1 * scale;
-                    y0 = p.y + glyph->y0 * scale;
-                    y1 = p.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
-                    {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + fLineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + fLineSpacing;
-
-                        p.x = originalPosition.x;
-                        p.y += fLineSpacing;
-                    }
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    p.x += glyph->xAdvance * scale;
-                    if(c != ' ' && plu_rect_contains_point(&tClipRect, p))
-                    {
-                        pl__prepare_draw_command(ptLayer, font->ptParentAtlas->tTexture, font->tConfig.bSdf);
-                        pl__reserve_triangles(ptLayer, 6, 4);
-                        uint32_t uVtxStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-                        pl__add_vertex(ptLayer, (plVec2){x0, y0}, color, (plVec2){s0, t0});
-                        pl__add_vertex(ptLayer, (plVec2){x1, y0}, color, (plVec2){s1, t0});
-                        pl__add_vertex(ptLayer, (plVec2){x1, y1}, color, (plVec2){s1, t1});
-                        pl__add_vertex(ptLayer, (plVec2){x0, y1}, color, (plVec2){s0, t1});
-
-                        pl__add_index(ptLayer, uVtxStart, 1, 0, 2);
-                        pl__add_index(ptLayer, uVtxStart, 2, 0, 3);
-                    }
-
-                    glyphFound = true;
-                    break;
-                }
-            }
-
-            assert(glyphFound && "Glyph not found");
-        }   
-    }   
+    pl__add_text_run(ptLayer, font, size, p, color, text, pcTextEnd, wrap, &tClipRect);
 }
 
 void
 pl_add_triangle(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness)
+{
+    pl_add_triangle_u32(ptLayer, tP0, tP1, tP2, plu_pack_color(tColor), fThickness);
+}
+
+void
+pl_add_triangle_u32(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, uint32_t uColor, float fThickness)
 {
     plu_sb_push(ptLayer->sbtPath, tP0);
     plu_sb_push(ptLayer->sbtPath, tP1);
     plu_sb_push(ptLayer->sbtPath, tP2);
-    plu_sb_push(ptLayer->sbtPath, tP0);
-    pl__submit_path(ptLayer, tColor, fThickness);    
+    pl__submit_path(ptLayer, uColor, fThickness, true);
 }
 
 void
 pl_add_triangle_filled(plDrawLayer* ptLayer, plVec2 p0, plVec2 p1, plVec2 p2, plVec4 color)
+{
+    pl_add_triangle_filled_u32(ptLayer, p0, p1, p2, plu_pack_color(color));
+}
+
+void
+pl_add_triangle_filled_u32(plDrawLayer* ptLayer, plVec2 p0, plVec2 p1, plVec2 p2, uint32_t uColor)
 {
     pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
     pl__reserve_triangles(ptLayer, 3, 3);
 
-    uint32_t vertexStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-    pl__add_vertex(ptLayer, p0, color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    pl__add_vertex(ptLayer, p1, color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    pl__add_vertex(ptLayer, p2, color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    uint32_t vertexStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    pl__add_vertex(ptLayer, p0, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    pl__add_vertex(ptLayer, p1, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    pl__add_vertex(ptLayer, p2, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
 
     pl__add_index(ptLayer, vertexStart, 0, 1, 2);
 }
 
 void
 pl_add_rect(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, float fThickness)
+{
+    pl_add_rect_u32(ptLayer, tMinP, tMaxP, plu_pack_color(tColor), fThickness);
+}
+
+void
+pl_add_rect_u32(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor, float fThickness)
 {
     const plVec2 fBotLeftVec  = {tMinP.x, tMaxP.y};
     const plVec2 fTopRightVec = {tMaxP.x, tMinP.y};
@@ -414,12 +594,17 @@ pl_add_rect(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, flo
     plu_sb_push(ptLayer->sbtPath, fBotLeftVec);
     plu_sb_push(ptLayer->sbtPath, tMaxP);
     plu_sb_push(ptLayer->sbtPath, fTopRightVec);
-    plu_sb_push(ptLayer->sbtPath, tMinP);
-    pl__submit_path(ptLayer, tColor, fThickness);   
+    pl__submit_path(ptLayer, uColor, fThickness, true);
 }
 
 void
 pl_add_rect_filled(plDrawLayer* ptLayer, plVec2 minP, plVec2 maxP, plVec4 color)
+{
+    pl_add_rect_filled_u32(ptLayer, minP, maxP, plu_pack_color(color));
+}
+
+void
+pl_add_rect_filled_u32(plDrawLayer* ptLayer, plVec2 minP, plVec2 maxP, uint32_t uColor)
 {
     pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
     pl__reserve_triangles(ptLayer, 6, 4);
@@ -427,149 +612,88 @@ pl_add_rect_filled(plDrawLayer* ptLayer, plVec2 minP, plVec2 maxP, plVec4 color)
     const plVec2 bottomLeft = { minP.x, maxP.y };
     const plVec2 topRight =   { maxP.x, minP.y };
 
-    const uint32_t vertexStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-    pl__add_vertex(ptLayer, minP,       color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    pl__add_vertex(ptLayer, bottomLeft, color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    pl__add_vertex(ptLayer, maxP,       color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    pl__add_vertex(ptLayer, topRight,   color, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    const uint32_t vertexStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    pl__add_vertex(ptLayer, minP,       uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    pl__add_vertex(ptLayer, bottomLeft, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    pl__add_vertex(ptLayer, maxP,       uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    pl__add_vertex(ptLayer, topRight,   uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
 
     pl__add_index(ptLayer, vertexStart, 0, 1, 2);
     pl__add_index(ptLayer, vertexStart, 0, 2, 3);
 }
 
-// segments is the number of segments used to approximate one corner
+// segments is the number of segments used to approximate one corner (0 for automatic)
 void
 pl_add_rect_rounded(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, float fThickness, float fRadius, uint32_t uSegments)
 {
-    if(uSegments == 0){ uSegments = 3; }
-    const float fIncrement = PLU_PI_2 / uSegments;
-    float fTheta = 0.0f;
-
-
-    const plVec2 bottomRightStart = { tMaxP.x, tMaxP.y - fRadius };
-    const plVec2 bottomRightInner = { tMaxP.x - fRadius, tMaxP.y - fRadius };
-    const plVec2 bottomRightEnd   = { tMaxP.x - fRadius, tMaxP.y };
-
-    const plVec2 bottomLeftStart  = { tMinP.x + fRadius, tMaxP.y };
-    const plVec2 bottomLeftInner  = { tMinP.x + fRadius, tMaxP.y - fRadius };
-    const plVec2 bottomLeftEnd    = { tMinP.x , tMaxP.y - fRadius};
- 
-    const plVec2 topLeftStart     = { tMinP.x, tMinP.y + fRadius };
-    const plVec2 topLeftInner     = { tMinP.x + fRadius, tMinP.y + fRadius };
-    const plVec2 topLeftEnd       = { tMinP.x + fRadius, tMinP.y };
-
-    const plVec2 topRightStart    = { tMaxP.x - fRadius, tMinP.y };
-    const plVec2 topRightInner    = { tMaxP.x - fRadius, tMinP.y + fRadius };
-    const plVec2 topRightEnd      = { tMaxP.x, tMinP.y + fRadius };
-    
-    plu_sb_push(ptLayer->sbtPath, bottomRightStart);
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
-    {
-        plu_sb_push(ptLayer->sbtPath, ((plVec2){bottomRightInner.x + fRadius * sinf(fTheta + PLU_PI_2), bottomRightInner.y + fRadius * sinf(fTheta)}));
-        fTheta += fIncrement;
-    }
-    plu_sb_push(ptLayer->sbtPath, bottomRightEnd);
-
-    plu_sb_push(ptLayer->sbtPath, bottomLeftStart);
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
-    {
-        plu_sb_push(ptLayer->sbtPath, ((plVec2){bottomLeftInner.x + fRadius * sinf(fTheta + PLU_PI_2), bottomLeftInner.y + fRadius * sinf(fTheta)}));
-        fTheta += fIncrement;
-    }
-    plu_sb_push(ptLayer->sbtPath, bottomLeftEnd);
+    pl_add_rect_rounded_u32(ptLayer, tMinP, tMaxP, plu_pack_color(tColor), fThickness, fRadius, uSegments);
+}
 
-    plu_sb_push(ptLayer->sbtPath, topLeftStart);
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
-    {
-        plu_sb_push(ptLayer->sbtPath, ((plVec2){topLeftInner.x + fRadius * sinf(fTheta + PLU_PI_2), topLeftInner.y + fRadius * sinf(fTheta)}));
-        fTheta += fIncrement;
-    }
-    plu_sb_push(ptLayer->sbtPath, topLeftEnd);
+void
+pl_add_rect_rounded_u32(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor, float fThickness, float fRadius, uint32_t uSegments)
+{
+    if(uSegments == 0){ uSegments = plu_max(1, pl__circle_segment_count(fRadius) / 4); }
+    uSegments = plu_min(uSegments, PL_UI_CIRCLE_SEGMENTS_MAX / 4);
+    const plVec2* atArc = pl__get_arc_table(uSegments * 4);
+
+    const plVec2 atCornerInner[4] = {
+        { tMaxP.x - fRadius, tMaxP.y - fRadius }, // bottom right
+        { tMinP.x + fRadius, tMaxP.y - fRadius }, // bottom left
+        { tMinP.x + fRadius, tMinP.y + fRadius }, // top left
+        { tMaxP.x - fRadius, tMinP.y + fRadius }  // top right
+    };
 
-    plu_sb_push(ptLayer->sbtPath, topRightStart);
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
+    // corner k sweeps [k * pi/2, (k + 1) * pi/2], so it owns arc entries [k * segments, (k + 1) * segments]
+    for(uint32_t k = 0; k < 4; k++)
     {
-        plu_sb_push(ptLayer->sbtPath, ((plVec2){topRightInner.x + fRadius * sinf(fTheta + PLU_PI_2), topRightInner.y + fRadius * sinf(fTheta)}));
-        fTheta += fIncrement;
+        for(uint32_t i = 0; i <= uSegments; i++)
+        {
+            const plVec2 tUnit = atArc[(k * uSegments + i) % (uSegments * 4)];
+            plu_sb_push(ptLayer->sbtPath, ((plVec2){atCornerInner[k].x + fRadius * tUnit.x, atCornerInner[k].y + fRadius * tUnit.y}));
+        }
     }
-    plu_sb_push(ptLayer->sbtPath, topRightEnd);
-
-    plu_sb_push(ptLayer->sbtPath, bottomRightStart);
 
-    pl__submit_path(ptLayer, tColor, fThickness);
+    pl__submit_path(ptLayer, uColor, fThickness, true);
 }
 
 void
 pl_add_rect_rounded_filled(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plVec4 tColor, float fRadius, uint32_t uSegments)
 {
-    if(uSegments == 0){ uSegments = 3; }
-    const uint32_t numTriangles = (uSegments * 4 + 4); //number segments in midpoint circle, plus square
-    pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
-    pl__reserve_triangles(ptLayer, numTriangles, numTriangles + 1);
-
-    const uint32_t uVertexStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
+    pl_add_rect_rounded_filled_u32(ptLayer, tMinP, tMaxP, plu_pack_color(tColor), fRadius, uSegments);
+}
 
-    const float fIncrement = PLU_PI_2 / uSegments;
-    float fTheta = 0.0f;
+void
+pl_add_rect_rounded_filled_u32(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, uint32_t uColor, float fRadius, uint32_t uSegments)
+{
+    if(uSegments == 0){ uSegments = plu_max(1, pl__circle_segment_count(fRadius) / 4); }
+    uSegments = plu_min(uSegments, PL_UI_CIRCLE_SEGMENTS_MAX / 4);
+    const plVec2* atArc = pl__get_arc_table(uSegments * 4);
 
-    const plVec2 bottomRightStart = { tMaxP.x, tMaxP.y - fRadius };
-    const plVec2 bottomRightInner = { tMaxP.x - fRadius, tMaxP.y - fRadius };
-    const plVec2 bottomRightEnd   = { tMaxP.x - fRadius, tMaxP.y };
+    const uint32_t numTriangles = (uSegments * 4 + 4); //number segments in midpoint circle, plus square
+    pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
+    pl__reserve_triangles(ptLayer, numTriangles * 3, numTriangles + 1);
 
-    const plVec2 bottomLeftStart  = { tMinP.x + fRadius, tMaxP.y };
-    const plVec2 bottomLeftInner  = { tMinP.x + fRadius, tMaxP.y - fRadius };
-    const plVec2 bottomLeftEnd    = { tMinP.x , tMaxP.y - fRadius};
- 
-    const plVec2 topLeftStart     = { tMinP.x, tMinP.y + fRadius };
-    const plVec2 topLeftInner     = { tMinP.x + fRadius, tMinP.y + fRadius };
-    const plVec2 topLeftEnd       = { tMinP.x + fRadius, tMinP.y };
+    const uint32_t uVertexStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    const plVec2 tWhiteUv = {gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]};
 
-    const plVec2 topRightStart    = { tMaxP.x - fRadius, tMinP.y };
-    const plVec2 topRightInner    = { tMaxP.x - fRadius, tMinP.y + fRadius };
-    const plVec2 topRightEnd      = { tMaxP.x, tMinP.y + fRadius };
+    const plVec2 atCornerInner[4] = {
+        { tMaxP.x - fRadius, tMaxP.y - fRadius }, // bottom right
+        { tMinP.x + fRadius, tMaxP.y - fRadius }, // bottom left
+        { tMinP.x + fRadius, tMinP.y + fRadius }, // top left
+        { tMaxP.x - fRadius, tMinP.y + fRadius }  // top right
+    };
 
     const plVec2 midPoint = {(tMaxP.x-tMinP.x)/2 + tMinP.x, (tMaxP.y-tMinP.y)/2 + tMinP.y};
-    pl__add_vertex(ptLayer, midPoint, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-
-    pl__add_vertex(ptLayer, bottomRightStart, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
-    {
-        pl__add_vertex(ptLayer, ((plVec2){bottomRightInner.x + fRadius * sinf(fTheta + PLU_PI_2), bottomRightInner.y + fRadius * sinf(fTheta)}), tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        fTheta += fIncrement;
-    }
-    pl__add_vertex(ptLayer, bottomRightEnd, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-
-    pl__add_vertex(ptLayer, bottomLeftStart, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
-    {
-        pl__add_vertex(ptLayer, ((plVec2){bottomLeftInner.x + fRadius * sinf(fTheta + PLU_PI_2), bottomLeftInner.y + fRadius * sinf(fTheta)}), tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        fTheta += fIncrement;
-    }
-    pl__add_vertex(ptLayer, bottomLeftEnd, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-
-    pl__add_vertex(ptLayer, topLeftStart, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
-    {
-        pl__add_vertex(ptLayer, ((plVec2){topLeftInner.x + fRadius * sinf(fTheta + PLU_PI_2), topLeftInner.y + fRadius * sinf(fTheta)}), tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        fTheta += fIncrement;
-    }
-    pl__add_vertex(ptLayer, topLeftEnd, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    pl__add_vertex(ptLayer, midPoint, uColor, tWhiteUv);
 
-    pl__add_vertex(ptLayer, topRightStart, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-    fTheta += fIncrement;
-    for(uint32_t i = 1; i < uSegments; i++)
+    for(uint32_t k = 0; k < 4; k++)
     {
-        pl__add_vertex(ptLayer, ((plVec2){topRightInner.x + fRadius * sinf(fTheta + PLU_PI_2), topRightInner.y + fRadius * sinf(fTheta)}), tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        fTheta += fIncrement;
+        for(uint32_t i = 0; i <= uSegments; i++)
+        {
+            const plVec2 tUnit = atArc[(k * uSegments + i) % (uSegments * 4)];
+            pl__add_vertex(ptLayer, ((plVec2){atCornerInner[k].x + fRadius * tUnit.x, atCornerInner[k].y + fRadius * tUnit.y}), uColor, tWhiteUv);
+        }
     }
-    pl__add_vertex(ptLayer, topRightEnd, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
 
     for(uint32_t i = 0; i < numTriangles - 1; i++)
         pl__add_index(ptLayer, uVertexStart, i + 1, 0, i + 2);
@@ -579,26 +703,37 @@ pl_add_rect_rounded_filled(plDrawLayer* ptLayer, plVec2 tMinP, plVec2 tMaxP, plV
 
 void
 pl_add_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness)
+{
+    pl_add_quad_u32(ptLayer, tP0, tP1, tP2, tP3, plu_pack_color(tColor), fThickness);
+}
+
+void
+pl_add_quad_u32(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, uint32_t uColor, float fThickness)
 {
     plu_sb_push(ptLayer->sbtPath, tP0);
     plu_sb_push(ptLayer->sbtPath, tP1);
     plu_sb_push(ptLayer->sbtPath, tP2);
     plu_sb_push(ptLayer->sbtPath, tP3);
-    plu_sb_push(ptLayer->sbtPath, tP0);
-    pl__submit_path(ptLayer, tColor, fThickness);
+    pl__submit_path(ptLayer, uColor, fThickness, true);
 }
 
 void
 pl_add_quad_filled(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor)
+{
+    pl_add_quad_filled_u32(ptLayer, tP0, tP1, tP2, tP3, plu_pack_color(tColor));
+}
+
+void
+pl_add_quad_filled_u32(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, uint32_t uColor)
 {
     pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
     pl__reserve_triangles(ptLayer, 6, 4);
 
-    const uint32_t uVtxStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-    pl__add_vertex(ptLayer, tP0, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // top left
-    pl__add_vertex(ptLayer, tP1, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // bot left
-    pl__add_vertex(ptLayer, tP2, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // bot right
-    pl__add_vertex(ptLayer, tP3, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // top right
+    const uint32_t uVtxStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    pl__add_vertex(ptLayer, tP0, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // top left
+    pl__add_vertex(ptLayer, tP1, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // bot left
+    pl__add_vertex(ptLayer, tP2, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // bot right
+    pl__add_vertex(ptLayer, tP3, uColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]}); // top right
 
     pl__add_index(ptLayer, uVtxStart, 0, 1, 2);
     pl__add_index(ptLayer, uVtxStart, 0, 2, 3);
@@ -607,34 +742,46 @@ pl_add_quad_filled(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plV
 void
 pl_add_circle(plDrawLayer* ptLayer, plVec2 tP, float fRadius, plVec4 tColor, uint32_t uSegments, float fThickness)
 {
-    if(uSegments == 0){ uSegments = 12; }
-    const float fIncrement = PLU_2PI / uSegments;
-    float fTheta = 0.0f;
+    pl_add_circle_u32(ptLayer, tP, fRadius, plu_pack_color(tColor), uSegments, fThickness);
+}
+
+void
+pl_add_circle_u32(plDrawLayer* ptLayer, plVec2 tP, float fRadius, uint32_t uColor, uint32_t uSegments, float fThickness)
+{
+    if(uSegments == 0){ uSegments = pl__circle_segment_count(fRadius); }
+    uSegments = plu_min(uSegments, PL_UI_CIRCLE_SEGMENTS_MAX);
+    const plVec2* atArc = pl__get_arc_table(uSegments);
     for(uint32_t i = 0; i < uSegments; i++)
     {
-        plu_sb_push(ptLayer->sbtPath, ((plVec2){tP.x + fRadius * sinf(fTheta + PLU_PI_2), tP.y + fRadius * sinf(fTheta)}));
-        fTheta += fIncrement;
+        const plVec2 tUnit = pl__arc_point(atArc, uSegments, i);
+        plu_sb_push(ptLayer->sbtPath, ((plVec2){tP.x + fRadius * tUnit.x, tP.y + fRadius * tUnit.y}));
     }
-    plu_sb_push(ptLayer->sbtPath, ((plVec2){tP.x + fRadius, tP.y}));
-    pl__submit_path(ptLayer, tColor, fThickness);   
+    pl__submit_path(ptLayer, uColor, fThickness, true);
 }
 
 void
 pl_add_circle_filled(plDrawLayer* ptLayer, plVec2 tP, float fRadius, plVec4 tColor, uint32_t uSegments)
 {
-    if(uSegments == 0){ uSegments = 12; }
+    pl_add_circle_filled_u32(ptLayer, tP, fRadius, plu_pack_color(tColor), uSegments);
+}
+
+void
+pl_add_circle_filled_u32(plDrawLayer* ptLayer, plVec2 tP, float fRadius, uint32_t uColor, uint32_t uSegments)
+{
+    if(uSegments == 0){ uSegments = pl__circle_segment_count(fRadius); }
+    uSegments = plu_min(uSegments, PL_UI_CIRCLE_SEGMENTS_MAX);
+    const plVec2* atArc = pl__get_arc_table(uSegments);
     pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
     pl__reserve_triangles(ptLayer, 3 * uSegments, uSegments + 1);
 
-    const uint32_t uVertexStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-    pl__add_vertex(ptLayer, tP, tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
+    const uint32_t uVertexStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    const plVec2 tWhiteUv = {gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]};
+    pl__add_vertex(ptLayer, tP, uColor, tWhiteUv);
 
-    const float fIncrement = PLU_2PI / uSegments;
-    float fTheta = 0.0f;
     for(uint32_t i = 0; i < uSegments; i++)
     {
-        pl__add_vertex(ptLayer, ((plVec2){tP.x + (fRadius * sinf(fTheta + PLU_PI_2)), tP.y + (fRadius * sinf(fTheta))}), tColor, (plVec2){gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]});
-        fTheta += fIncrement;
+        const plVec2 tUnit = pl__arc_point(atArc, uSegments, i);
+        pl__add_vertex(ptLayer, ((plVec2){tP.x + fRadius * tUnit.x, tP.y + fRadius * tUnit.y}), uColor, tWhiteUv);
     }
 
     for(uint32_t i = 0; i < uSegments - 1; i++)
@@ -657,11 +804,12 @@ pl_add_image_ex(plDrawLayer* ptLayer, plTextureId tTexture, plVec2 tPMin, plVec2
     const plVec2 bottomLeft = { tPMin.x, tPMax.y };
     const plVec2 topRight =   { tPMax.x, tPMin.y };
 
-    const uint32_t vertexStart = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer);
-    pl__add_vertex(ptLayer, tPMin,       tColor, tUvMin);
-    pl__add_vertex(ptLayer, bottomLeft, tColor, (plVec2){tUvMin.x, tUvMax.y});
-    pl__add_vertex(ptLayer, tPMax,       tColor, tUvMax);
-    pl__add_vertex(ptLayer, topRight,   tColor, (plVec2){tUvMax.x, tUvMin.y});
+    const uint32_t uColor = plu_pack_color(tColor);
+    const uint32_t vertexStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    pl__add_vertex(ptLayer, tPMin,      uColor, tUvMin);
+    pl__add_vertex(ptLayer, bottomLeft, uColor, (plVec2){tUvMin.x, tUvMax.y});
+    pl__add_vertex(ptLayer, tPMax,      uColor, tUvMax);
+    pl__add_vertex(ptLayer, topRight,   uColor, (plVec2){tUvMax.x, tUvMin.y});
 
     pl__add_index(ptLayer, vertexStart, 0, 1, 2);
     pl__add_index(ptLayer, vertexStart, 0, 2, 3);
@@ -670,6 +818,12 @@ pl_add_image_ex(plDrawLayer* ptLayer, plTextureId tTexture, plVec2 tPMin, plVec2
 // order of the bezier curve inputs are 0=start, 1=control, 2=ending
 void
 pl_add_bezier_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec4 tColor, float fThickness, uint32_t uSegments)
+{
+    pl_add_bezier_quad_u32(ptLayer, tP0, tP1, tP2, plu_pack_color(tColor), fThickness, uSegments);
+}
+
+void
+pl_add_bezier_quad_u32(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, uint32_t uColor, float fThickness, uint32_t uSegments)
 {
 
     if(uSegments == 0)
@@ -698,12 +852,18 @@ pl_add_bezier_quad(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plV
     // push last point
     plu_sb_push(ptLayer->sbtPath, tP2);
 
-    pl__submit_path(ptLayer, tColor, fThickness); 
+    pl__submit_path(ptLayer, uColor, fThickness, false);
 }
 
 // order of the bezier curve inputs are 0=start, 1=control 1, 2=control 2, 3=ending
 void
 pl_add_bezier_cubic(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, plVec4 tColor, float fThickness, uint32_t uSegments)
+{
+    pl_add_bezier_cubic_u32(ptLayer, tP0, tP1, tP2, tP3, plu_pack_color(tColor), fThickness, uSegments);
+}
+
+void
+pl_add_bezier_cubic_u32(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, plVec2 tP3, uint32_t uColor, float fThickness, uint32_t uSegments)
 {
 
     if(uSegments == 0)
@@ -736,18 +896,30 @@ pl_add_bezier_cubic(plDrawLayer* ptLayer, plVec2 tP0, plVec2 tP1, plVec2 tP2, pl
     // push last point
     plu_sb_push(ptLayer->sbtPath, tP3);
 
-    pl__submit_path(ptLayer, tColor, fThickness); 
+    pl__submit_path(ptLayer, uColor, fThickness, false);
 }
 
-void
+plFont*
 pl_add_font_from_file_ttf(plFontAtlas* atlas, plFontConfig config, const char* file)
 {
-    void* data = plu__read_file(file); // freed after atlas is created
-    pl_add_font_from_memory_ttf(atlas, config, data);
+    // mapped (or read) data is released after atlas is created
+    size_t szSize = 0;
+    void* data = pl__map_file(file, &szSize);
+    const bool bMapped = data != NULL;
+    if(data == NULL)
+        data = plu__read_file(file, &szSize);
+    return pl__add_font(atlas, config, data, szSize, bMapped, NULL);
 }
 
-void
+plFont*
 pl_add_font_from_memory_ttf(plFontAtlas* atlas, plFontConfig config, void* data)
+{
+    // size unknown (0), the data is trusted to be a well formed ttf
+    return pl__add_font(atlas, config, data, 0, false, NULL);
+}
+
+static plFont*
+pl__add_font(plFontAtlas* atlas, plFontConfig config, void* pTtf, size_t szTtfSize, bool bMapped, const char* pcCompressedTtf)
 {
     atlas->bDirty = true;
     atlas->iGlyphPadding = 1;
@@ -757,29 +929,6 @@ pl_add_font_from_memory_ttf(plFontAtlas* atlas, plFontConfig config, void* data)
         .tConfig = config
     };
 
-    // prepare stb
-    plFontPrepData prep = {0};
-    stbtt_InitFont(&prep.fontInfo, (unsigned char*)data, 0);
-
-    // get vertical font metrics
-    int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&prep.fontInfo, &ascent, &descent, &lineGap);
-
-    // calculate scaling factor
-    prep.scale = 1.0f;
-    if(font.tConfig.fFontSize > 0) prep.scale = stbtt_ScaleForPixelHeight(&prep.fontInfo, font.tConfig.fFontSize);
-    else                         prep.scale = stbtt_ScaleForMappingEmToPixels(&prep.fontInfo, -font.tConfig.fFontSize);
-
-    // calculate SDF pixel increment
-    if(font.tConfig.bSdf) font.tConfig.fSdfPixelDistScale = (float)font.tConfig.ucOnEdgeValue / (float) font.tConfig.iSdfPadding;
-
-    // calculate base line spacing
-    int ascentBias = -1;
-    int descentBias = -1;
-    font.fAscent = floorf(ascent * prep.scale - ascentBias);
-    font.fDescent = floorf(descent * prep.scale - descentBias);
-    font.fLineSpacing = (font.fAscent - font.fDescent + prep.scale * (float)lineGap);
-
     // convert individual chars to ranges
     for(uint32_t i = 0; i < plu_sb_size(font.tConfig.sbiIndividualChars); i++)
     {
@@ -791,6 +940,10 @@ pl_add_font_from_memory_ttf(plFontAtlas* atlas, plFontConfig config, void* data)
         plu_sb_push(font.tConfig.sbtRanges, range);
     }
 
+    // nothing is rasterized up front for dynamic fonts
+    if(font.tConfig.bDynamic)
+        plu_sb_reset(font.tConfig.sbtRanges);
+
     // find total number of glyphs/chars required
     uint32_t totalCharCount = 0u;
     for(uint32_t i = 0; i < plu_sb_size(font.tConfig.sbtRanges); i++)
@@ -799,109 +952,136 @@ pl_add_font_from_memory_ttf(plFontAtlas* atlas, plFontConfig config, void* data)
     plu_sb_reserve(font.sbtGlyphs, totalCharCount);
     plu_sb_resize(font.sbtCharData, totalCharCount);
 
-    if(font.tConfig.bSdf)
-        plu_sb_reserve(atlas->sbtCustomRects, plu_sb_size(atlas->sbtCustomRects) + totalCharCount); // is this correct
+    // glyph work is deferred to pl_build_font_atlas (& skipped entirely on a cache hit)
+    plFontPrepData prep = {
+        .ptrTtf          = pTtf,
+        .szMappedSize    = bMapped ? szTtfSize : 0,
+        .pcCompressedTtf = pcCompressedTtf,
+        .uKey            = pl__hash_font(&font.tConfig, pTtf, szTtfSize, pcCompressedTtf)
+    };
+
+    // add font to atlas (allocated on its own so pointers handed out stay valid
+    // as more fonts are added)
+    font.ptParentAtlas = atlas;
+    font._uIndex = plu_sb_size(atlas->sbtFonts);
+    plFont* ptFont = pl_memory_alloc(sizeof(plFont));
+    *ptFont = font;
+    plu_sb_push(atlas->sbtFonts, ptFont);
+    plu_sb_push(atlas->_sbtPrepData, prep);
+    return ptFont;
+}
+
+static void
+pl__prepare_font(plFontAtlas* atlas, plFont* ptFont, plFontPrepData* ptPrep)
+{
+    // embedded default font is only decompressed when actually needed
+    if(ptPrep->ptrTtf == NULL && ptPrep->pcCompressedTtf)
+        ptPrep->ptrTtf = pl__decompress_default_font(ptPrep->pcCompressedTtf);
+
+    // prepare stb
+    stbtt_InitFont(&ptPrep->fontInfo, ptPrep->ptrTtf, 0);
+
+    // get vertical font metrics
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(&ptPrep->fontInfo, &ascent, &descent, &lineGap);
+
+    // calculate scaling factor
+    ptPrep->scale = 1.0f;
+    if(ptFont->tConfig.fFontSize > 0) ptPrep->scale = stbtt_ScaleForPixelHeight(&ptPrep->fontInfo, ptFont->tConfig.fFontSize);
+    else                              ptPrep->scale = stbtt_ScaleForMappingEmToPixels(&ptPrep->fontInfo, -ptFont->tConfig.fFontSize);
+
+    // calculate SDF pixel increment
+    if(ptFont->tConfig.bSdf) ptFont->tConfig.fSdfPixelDistScale = (float)ptFont->tConfig.ucOnEdgeValue / (float) ptFont->tConfig.iSdfPadding;
+
+    // calculate base line spacing
+    int ascentBias = -1;
+    int descentBias = -1;
+    ptFont->fAscent = floorf(ascent * ptPrep->scale - ascentBias);
+    ptFont->fDescent = floorf(descent * ptPrep->scale - descentBias);
+    ptFont->fLineSpacing = (ptFont->fAscent - ptFont->fDescent + ptPrep->scale * (float)lineGap);
+
+    // glyphs are rasterized on first use
+    if(ptFont->tConfig.bDynamic)
+        return;
 
-    prep.ranges = pl_memory_alloc(sizeof(stbtt_pack_range) * plu_sb_size(font.tConfig.sbtRanges));
-    memset(prep.ranges, 0, sizeof(stbtt_pack_range) * plu_sb_size(font.tConfig.sbtRanges));
+    // find total number of glyphs/chars required
+    uint32_t totalCharCount = plu_sb_size(ptFont->sbtCharData);
+
+    int* aiSdfCodePoints = NULL;
+    if(ptFont->tConfig.bSdf)
+        aiSdfCodePoints = pl_memory_alloc(sizeof(int) * totalCharCount);
+
+    ptPrep->ranges = pl_memory_alloc(sizeof(stbtt_pack_range) * plu_sb_size(ptFont->tConfig.sbtRanges));
+    memset(ptPrep->ranges, 0, sizeof(stbtt_pack_range) * plu_sb_size(ptFont->tConfig.sbtRanges));
 
     // find max codepoint & set range pointers into font char data
     int k = 0;
-    int maxCodePoint = 0;
     totalCharCount = 0u;
     bool missingGlyphAdded = false;
 
-    for(uint32_t i = 0; i < plu_sb_size(font.tConfig.sbtRanges); i++)
+    for(uint32_t i = 0; i < plu_sb_size(ptFont->tConfig.sbtRanges); i++)
     {
-        plFontRange* range = &font.tConfig.sbtRanges[i];
-        prep.uTotalCharCount += range->uCharCount;
+        plFontRange* range = &ptFont->tConfig.sbtRanges[i];
+        ptPrep->uTotalCharCount += range->uCharCount;
     }
 
-    if(!font.tConfig.bSdf)
+    if(!ptFont->tConfig.bSdf)
     {
-        prep.rects = pl_memory_alloc(sizeof(stbrp_rect) * prep.uTotalCharCount);
+        ptPrep->rects = pl_memory_alloc(sizeof(stbrp_rect) * ptPrep->uTotalCharCount);
     }
 
-    for(uint32_t i = 0; i < plu_sb_size(font.tConfig.sbtRanges); i++)
+    for(uint32_t i = 0; i < plu_sb_size(ptFont->tConfig.sbtRanges); i++)
     {
-        plFontRange* range = &font.tConfig.sbtRanges[i];
-
-        if(range->iFirstCodePoint + (int)range->uCharCount > maxCodePoint)
-            maxCodePoint = range->iFirstCodePoint + (int)range->uCharCount;
+        plFontRange* range = &ptFont->tConfig.sbtRanges[i];
 
-        range->ptFontChar = &font.sbtCharData[totalCharCount];
+        range->ptFontChar = &ptFont->sbtCharData[totalCharCount];
 
         // prepare stb stuff
-        prep.ranges[i].font_size = font.tConfig.fFontSize;
-        prep.ranges[i].first_unicode_codepoint_in_range = range->iFirstCodePoint;
-        prep.ranges[i].chardata_for_range = (stbtt_packedchar*)range->ptFontChar;
-        prep.ranges[i].num_chars = range->uCharCount;
-        prep.ranges[i].h_oversample = (unsigned char) font.tConfig.uHOverSampling;
-        prep.ranges[i].v_oversample = (unsigned char) font.tConfig.uVOverSampling;
+        ptPrep->ranges[i].font_size = ptFont->tConfig.fFontSize;
+        ptPrep->ranges[i].first_unicode_codepoint_in_range = range->iFirstCodePoint;
+        ptPrep->ranges[i].chardata_for_range = (stbtt_packedchar*)range->ptFontChar;
+        ptPrep->ranges[i].num_chars = range->uCharCount;
+        ptPrep->ranges[i].h_oversample = (unsigned char) ptFont->tConfig.uHOverSampling;
+        ptPrep->ranges[i].v_oversample = (unsigned char) ptFont->tConfig.uVOverSampling;
 
         // flag all characters as NOT packed
-        memset(prep.ranges[i].chardata_for_range, 0, sizeof(stbtt_packedchar) * range->uCharCount);
+        memset(ptPrep->ranges[i].chardata_for_range, 0, sizeof(stbtt_packedchar) * range->uCharCount);
 
-        if(font.tConfig.bSdf)
+        if(ptFont->tConfig.bSdf)
         {
-            for (uint32_t j = 0; j < (uint32_t)prep.ranges[i].num_chars; j++) 
+            // glyphs themselves are generated below (possibly in parallel)
+            for (uint32_t j = 0; j < (uint32_t)ptPrep->ranges[i].num_chars; j++) 
             {
-                int codePoint = 0;
-                if(prep.ranges[i].array_of_unicode_codepoints) codePoint = prep.ranges[i].array_of_unicode_codepoints[j];
-                else                                           codePoint = prep.ranges[i].first_unicode_codepoint_in_range + j;
-
-
-                int width = 0u;
-                int height = 0u;
-                int xOff = 0u;
-                int yOff = 0u;
-                unsigned char* bytes = stbtt_GetCodepointSDF(&prep.fontInfo, stbtt_ScaleForPixelHeight(&prep.fontInfo, font.tConfig.fFontSize), codePoint, font.tConfig.iSdfPadding, font.tConfig.ucOnEdgeValue, font.tConfig.fSdfPixelDistScale, &width, &height, &xOff, &yOff);
-
-                int xAdvance = 0u;
-                stbtt_GetCodepointHMetrics(&prep.fontInfo, codePoint, &xAdvance, NULL);
-
-                range->ptFontChar[j].xOff = (float)(xOff);
-                range->ptFontChar[j].yOff = (float)(yOff);
-                range->ptFontChar[j].xOff2 = (float)(xOff + width);
-                range->ptFontChar[j].yOff2 = (float)(yOff + height);
-                range->ptFontChar[j].xAdv = prep.scale * (float)xAdvance;
-
-                plFontCustomRect customRect = {
-                    .uWidth = (uint32_t)width,
-                    .uHeight = (uint32_t)height,
-                    .pucBytes = bytes
-                };
-                plu_sb_push(atlas->sbtCustomRects, customRect);
-                prep.area += width * height;
-                
+                if(ptPrep->ranges[i].array_of_unicode_codepoints) aiSdfCodePoints[totalCharCount + j] = ptPrep->ranges[i].array_of_unicode_codepoints[j];
+                else                                           aiSdfCodePoints[totalCharCount + j] = ptPrep->ranges[i].first_unicode_codepoint_in_range + j;
             }
-            k += prep.ranges[i].num_chars;
+            k += ptPrep->ranges[i].num_chars;
         }
         else // regular font
         {
             for(uint32_t j = 0; j < range->uCharCount; j++)
             {
                 int codepoint = 0;
-                if(prep.ranges[i].array_of_unicode_codepoints) codepoint = prep.ranges[i].array_of_unicode_codepoints[j];
-                else                                           codepoint = prep.ranges[i].first_unicode_codepoint_in_range + j;
+                if(ptPrep->ranges[i].array_of_unicode_codepoints) codepoint = ptPrep->ranges[i].array_of_unicode_codepoints[j];
+                else                                           codepoint = ptPrep->ranges[i].first_unicode_codepoint_in_range + j;
 
                 // bitmap
-                int glyphIndex = stbtt_FindGlyphIndex(&prep.fontInfo, codepoint);
+                int glyphIndex = stbtt_FindGlyphIndex(&ptPrep->fontInfo, codepoint);
                 if(glyphIndex == 0 && missingGlyphAdded)
-                    prep.rects[k].w = prep.rects[k].h = 0;
+                    ptPrep->rects[k].w = ptPrep->rects[k].h = 0;
                 else
                 {
                     int x0 = 0;
                     int y0 = 0;
                     int x1 = 0;
                     int y1 = 0;
-                    stbtt_GetGlyphBitmapBoxSubpixel(&prep.fontInfo, glyphIndex,
-                                                    prep.scale * font.tConfig.uHOverSampling,
-                                                    prep.scale * font.tConfig.uVOverSampling,
+                    stbtt_GetGlyphBitmapBoxSubpixel(&ptPrep->fontInfo, glyphIndex,
+                                                    ptPrep->scale * ptFont->tConfig.uHOverSampling,
+                                                    ptPrep->scale * ptFont->tConfig.uVOverSampling,
                                                     0, 0, &x0, &y0, &x1, &y1);
-                    prep.rects[k].w = (stbrp_coord)(x1 - x0 + atlas->iGlyphPadding + font.tConfig.uHOverSampling - 1);
-                    prep.rects[k].h = (stbrp_coord)(y1 - y0 + atlas->iGlyphPadding + font.tConfig.uVOverSampling - 1);
-                    prep.area += prep.rects[k].w * prep.rects[k].h;
+                    ptPrep->rects[k].w = (stbrp_coord)(x1 - x0 + atlas->iGlyphPadding + ptFont->tConfig.uHOverSampling - 1);
+                    ptPrep->rects[k].h = (stbrp_coord)(y1 - y0 + atlas->iGlyphPadding + ptFont->tConfig.uVOverSampling - 1);
+                    ptPrep->area += ptPrep->rects[k].w * ptPrep->rects[k].h;
                     if (glyphIndex == 0) missingGlyphAdded = true; 
                 }
                 k++;
@@ -909,12 +1089,28 @@ pl_add_font_from_memory_ttf(plFontAtlas* atlas, plFontConfig config, void* data)
         }
         totalCharCount += range->uCharCount;
     }
-    plu_sb_resize(font.sbuCodePoints, (uint32_t)maxCodePoint);
 
-    // add font to atlas
-    font.ptParentAtlas = atlas;
-    plu_sb_push(atlas->sbtFonts, font);
-    plu_sb_push(atlas->_sbtPrepData, prep);
+    if(ptFont->tConfig.bSdf)
+    {
+        const uint32_t uFirstRect = plu_sb_size(atlas->sbtCustomRects);
+        plu_sb_resize(atlas->sbtCustomRects, uFirstRect + totalCharCount);
+
+        plSdfGlyphJob tJob = {
+            .ptFontInfo   = &ptPrep->fontInfo,
+            .ptConfig     = &ptFont->tConfig,
+            .aiCodePoints = aiSdfCodePoints,
+            .atChars      = ptFont->sbtCharData,
+            .atRects      = &atlas->sbtCustomRects[uFirstRect],
+            .uGlyphCount  = totalCharCount,
+            .fScale       = ptPrep->scale
+        };
+        pl__dispatch_jobs(pl__generate_sdf_glyphs, &tJob, (totalCharCount + PL_UI_SDF_GLYPHS_PER_JOB - 1) / PL_UI_SDF_GLYPHS_PER_JOB, NULL);
+
+        for(uint32_t i = 0; i < totalCharCount; i++)
+            ptPrep->area += tJob.atRects[i].uWidth * tJob.atRects[i].uHeight;
+        pl_memory_free(aiSdfCodePoints);
+    }
+
 }
 
 plVec2
@@ -927,98 +1123,10 @@ pl_calculate_text_size(plFont* font, float size, const char* text, float wrap)
 plVec2
 pl_calculate_text_size_ex(plFont* font, float size, const char* text, const char* pcTextEnd, float wrap)
 {
-    plVec2 result = {0};
-    plVec2 cursor = {0};
-
-    float scale = size > 0.0f ? size / font->tConfig.fFontSize : 1.0f;
-
-    float fLineSpacing = scale * font->fLineSpacing;
-    plVec2 originalPosition = {FLT_MAX, FLT_MAX};
-    bool firstCharacter = true;
-
-    while(text < pcTextEnd)
-    {
-        uint32_t c = (uint32_t)*text;
-        if(c < 0x80)
-            text += 1;
-        else
-        {
-            text += plu_text_char_from_utf8(&c, text, NULL);
-            if(c == 0) // malformed UTF-8?
-                break;
-        }
-
-        if(c == '\n')
-        {
-            cursor.x = originalPosition.x;
-            cursor.y += fLineSpacing;
-        }
-        else if(c == '\r')
-        {
-            // do nothing
-        }
-        else
-        {
-
-            bool glyphFound = false;
-            for(uint32_t i = 0u; i < plu_sb_size(font->tConfig.sbtRanges); i++)
-            {
-                if (c >= (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint && c < (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint + (uint32_t)font->tConfig.sbtRanges[i].uCharCount) 
-                {
-
-                    
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
-                    const plFontGlyph* glyph = &font->sbtGlyphs[font->sbuCodePoints[c]];
-
-                    // adjust for left side bearing if first char
-                    if(firstCharacter)
-                    {
-                        if(glyph->leftBearing > 0.0f) cursor.x += glyph->leftBearing * scale;
-                        firstCharacter = false;
-                        originalPosition.x = cursor.x + glyph->x0 * scale;
-                        originalPosition.y = cursor.y + glyph->y0 * scale;
-                    }
-
-                    x0 = cursor.x + glyph->x0 * scale;
-                    x1 = cursor.x + glyph->x1 * scale;
-                    y0 = cursor.y + glyph->y0 * scale;
-                    y1 = cursor.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
-                    {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + fLineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + fLineSpacing;
-
-                        cursor.x = originalPosition.x;
-                        cursor.y += fLineSpacing;
-                    }
-
-                    if(x0 < originalPosition.x) originalPosition.x = x0;
-                    if(y0 < originalPosition.y) originalPosition.y = y0;
-
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    if(x1 > result.x) result.x = x1;
-                    if(y1 > result.y) result.y = y1;
-
-                    cursor.x += glyph->xAdvance * scale;
-                    glyphFound = true;
-                    break;
-                }
-            }
-
-            assert(glyphFound && "Glyph not found");
-        }   
-    }
-
-    return plu_sub_vec2(result, originalPosition);
+    plVec2 tMin = {0};
+    plVec2 tMax = {0};
+    pl__measure_text(font, size, text, pcTextEnd, wrap, &tMin, &tMax);
+    return plu_sub_vec2(tMax, tMin);
 }
 
 plRect
@@ -1031,101 +1139,12 @@ pl_calculate_text_bb(plFont* ptFont, float fSize, plVec2 tP, const char* pcText,
 plRect
 pl_calculate_text_bb_ex(plFont* font, float size, plVec2 tP, const char* text, const char* pcTextEnd, float wrap)
 {
-    plVec2 tTextSize = {0};
-    plVec2 cursor = {0};
-
-    float scale = size > 0.0f ? size / font->tConfig.fFontSize : 1.0f;
-
-    float fLineSpacing = scale * font->fLineSpacing;
-    plVec2 originalPosition = {FLT_MAX, FLT_MAX};
-    bool firstCharacter = true;
-
-    while(text < pcTextEnd)
-    {
-        uint32_t c = (uint32_t)*text;
-        if(c < 0x80)
-            text += 1;
-        else
-        {
-            text += plu_text_char_from_utf8(&c, text, NULL);
-            if(c == 0) // malformed UTF-8?
-                break;
-        }
-
-        if(c == '\n')
-        {
-            cursor.x = originalPosition.x;
-            cursor.y += fLineSpacing;
-        }
-        else if(c == '\r')
-        {
-            // do nothing
-        }
-        else
-        {
-
-            bool glyphFound = false;
-            for(uint32_t i = 0u; i < plu_sb_size(font->tConfig.sbtRanges); i++)
-            {
-                if (c >= (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint && c < (uint32_t)font->tConfig.sbtRanges[i].iFirstCodePoint + (uint32_t)font->tConfig.sbtRanges[i].uCharCount) 
-                {
-
-                    float x0,y0,s0,t0; // top-left
-                    float x1,y1,s1,t1; // bottom-right
-
-                    const plFontGlyph* glyph = &font->sbtGlyphs[font->sbuCodePoints[c]];
-
-                    // adjust for left side bearing if first char
-                    if(firstCharacter)
-                    {
-                        if(glyph->leftBearing > 0.0f) cursor.x += glyph->leftBearing * scale;
-                        firstCharacter = false;
-                        originalPosition.x = cursor.x + glyph->x0 * scale;
-                        originalPosition.y = cursor.y + glyph->y0 * scale;
-                    }
-
-                    x0 = cursor.x + glyph->x0 * scale;
-                    x1 = cursor.x + glyph->x1 * scale;
-                    y0 = cursor.y + glyph->y0 * scale;
-                    y1 = cursor.y + glyph->y1 * scale;
-
-                    if(wrap > 0.0f && x1 > originalPosition.x + wrap)
-                    {
-                        x0 = originalPosition.x + glyph->x0 * scale;
-                        y0 = y0 + fLineSpacing;
-                        x1 = originalPosition.x + glyph->x1 * scale;
-                        y1 = y1 + fLineSpacing;
-
-                        cursor.x = originalPosition.x;
-                        cursor.y += fLineSpacing;
-                    }
-
-                    if(x0 < originalPosition.x) originalPosition.x = x0;
-                    if(y0 < originalPosition.y) originalPosition.y = y0;
-
-                    s0 = glyph->u0;
-                    t0 = glyph->v0;
-                    s1 = glyph->u1;
-                    t1 = glyph->v1;
-
-                    if(x1 > tTextSize.x)
-                        tTextSize.x = x1;
-                    if(y1 > tTextSize.y)
-                        tTextSize.y = y1;
-
-                    cursor.x += glyph->xAdvance * scale;
-                    glyphFound = true;
-                    break;
-                }
-            }
+    plVec2 tMin = {0};
+    plVec2 tMax = {0};
+    pl__measure_text(font, size, text, pcTextEnd, wrap, &tMin, &tMax);
 
-            assert(glyphFound && "Glyph not found");
-        }   
-    }
-
-    tTextSize = plu_sub_vec2(tTextSize, originalPosition);
-
-    const plVec2 tStartOffset = plu_add_vec2(tP, originalPosition);
+    const plVec2 tTextSize = plu_sub_vec2(tMax, tMin);
+    const plVec2 tStartOffset = plu_add_vec2(tP, tMin);
 
     const plRect tResult = plu_calculate_rect(tStartOffset, tTextSize);
 
@@ -1160,9 +1179,65 @@ pl_get_clip_rect(plDrawList* ptDrawlist)
     return NULL;
 }
 
+void
+pl_push_layer_clip_rect(plDrawLayer* ptLayer, plRect tRect, bool bAccumulate)
+{
+    if(bAccumulate && plu_sb_size(ptLayer->sbtClipStack) > 0)
+        tRect = plu_rect_clip_full(&tRect, &plu_sb_back(ptLayer->sbtClipStack));
+    plu_sb_push(ptLayer->sbtClipStack, tRect);
+}
+
+void
+pl_pop_layer_clip_rect(plDrawLayer* ptLayer)
+{
+    plu_sb_pop(ptLayer->sbtClipStack);
+}
+
+const plRect*
+pl_get_layer_clip_rect(plDrawLayer* ptLayer)
+{
+    if(plu_sb_size(ptLayer->sbtClipStack) > 0)
+        return &plu_sb_back(ptLayer->sbtClipStack);
+    return pl_get_clip_rect(ptLayer->ptDrawlist);
+}
+
 void
 pl_build_font_atlas(plFontAtlas* atlas)
 {
+    if(gptCtx)
+        pl__invalidate_text_cache();
+
+    // dynamic fonts keep their ttf & state around, so those atlases are never cached
+    bool bHasDynamicFonts = false;
+    for(uint32_t i = 0u; i < plu_sb_size(atlas->sbtFonts); i++)
+        bHasDynamicFonts |= atlas->sbtFonts[i]->tConfig.bDynamic;
+
+    // full upload follows a build
+    plu_sb_reset(atlas->sbtDirtyRects);
+    plu_sb_reset(atlas->_sbtShelves);
+    pl__free_font_packer(atlas);
+
+    // identical fonts & configs as a baked array or previous run, skip straight
+    // to the finished atlas
+    bool bLoaded = false;
+    if(!bHasDynamicFonts && atlas->pucBakedData)
+        bLoaded = pl__load_font_atlas_data(atlas, atlas->pucBakedData, atlas->szBakedDataSize, true);
+    if(!bHasDynamicFonts && !bLoaded && atlas->pcCacheFile)
+        bLoaded = pl__load_font_atlas_cache(atlas);
+    if(bLoaded)
+    {
+        for(uint32_t i = 0u; i < plu_sb_size(atlas->_sbtPrepData); i++)
+            pl__release_font_data(&atlas->_sbtPrepData[i]);
+        atlas->_uDynamicY = atlas->auAtlasSize[1];
+        atlas->_uDynamicEndY = atlas->auAtlasSize[1];
+        atlas->_uBuiltFontCount = plu_sb_size(atlas->sbtFonts);
+        return;
+    }
+
+    // per glyph work (SDF generation & bitmap glyph boxes)
+    for(uint32_t i = 0u; i < plu_sb_size(atlas->_sbtPrepData); i++)
+        pl__prepare_font(atlas, atlas->sbtFonts[i], &atlas->_sbtPrepData[i]);
+
     // calculate texture total area needed
     uint32_t totalAtlasArea = 0u;
     for(uint32_t i = 0u; i < plu_sb_size(atlas->_sbtPrepData); i++)
@@ -1207,266 +1282,1924 @@ pl_build_font_atlas(plFontAtlas* atlas)
     // pack bitmap fonts
     for(uint32_t i = 0u; i < plu_sb_size(atlas->_sbtPrepData); i++)
     {
-        plFont* font = &atlas->sbtFonts[i];
-        if(!font->tConfig.bSdf)
+        plFont* font = atlas->sbtFonts[i];
+        if(!font->tConfig.bSdf && !font->tConfig.bDynamic)
+        {
+            plFontPrepData* prep = &atlas->_sbtPrepData[i];
+            stbtt_PackSetOversampling(&spc, font->tConfig.uHOverSampling, font->tConfig.uVOverSampling);
+            stbrp_pack_rects((stbrp_context*)spc.pack_info, prep->rects, prep->uTotalCharCount);
+            for(uint32_t j = 0u; j < prep->uTotalCharCount; j++)
+            {
+                if(prep->rects[j].was_packed)
+                    atlas->auAtlasSize[1] = (uint32_t)pl__get_max((float)atlas->auAtlasSize[1], (float)(prep->rects[j].y + prep->rects[j].h));
+            }
+        }
+    }
+
+    // pack SDF fonts
+    stbtt_PackSetOversampling(&spc, 1, 1);
+    stbrp_pack_rects((stbrp_context*)spc.pack_info, rects, plu_sb_size(atlas->sbtCustomRects));
+
+    for(uint32_t i = 0u; i < plu_sb_size(atlas->sbtCustomRects); i++)
+    {
+        if(rects[i].was_packed)
+            atlas->auAtlasSize[1] = (uint32_t)pl__get_max((float)atlas->auAtlasSize[1], (float)(rects[i].y + rects[i].h));
+    }
+
+    // fixed size region for dynamic fonts below everything packed (with a
+    // gutter so filtering never reaches packed glyphs)
+    atlas->_uDynamicY = atlas->auAtlasSize[1];
+    if(bHasDynamicFonts)
+    {
+        // reserved in the skyline too, so pl_update_font_atlas packs around it
+        stbrp_rect tRegion = {
+            .w = (stbrp_coord)(atlas->auAtlasSize[0] - (uint32_t)atlas->iGlyphPadding), // packer width
+            .h = (stbrp_coord)(atlas->iGlyphPadding + (atlas->uDynamicHeight > 0 ? atlas->uDynamicHeight : PL_UI_ATLAS_DYNAMIC_HEIGHT))
+        };
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, &tRegion, 1);
+        atlas->_uDynamicY = (uint32_t)tRegion.y + (uint32_t)atlas->iGlyphPadding;
+        atlas->auAtlasSize[1] = (uint32_t)(tRegion.y + tRegion.h);
+    }
+    atlas->_uDynamicEndY = atlas->auAtlasSize[1];
+
+    // grow cpu side buffers if needed
+    if(atlas->szPixelDataSize < atlas->auAtlasSize[0] * atlas->auAtlasSize[1] || atlas->_bBorrowedPixels || (!atlas->bAlpha8Only && !atlas->pucPixelsAsRGBA32))
+    {
+        if(atlas->pucPixelsAsAlpha8 && !atlas->_bBorrowedPixels) pl_memory_free(atlas->pucPixelsAsAlpha8);
+        if(atlas->pucPixelsAsRGBA32) pl_memory_free(atlas->pucPixelsAsRGBA32);
+
+        atlas->pucPixelsAsAlpha8 = pl_memory_alloc(atlas->auAtlasSize[0] * atlas->auAtlasSize[1]);   
+        atlas->pucPixelsAsRGBA32 = atlas->bAlpha8Only ? NULL : pl_memory_alloc(atlas->auAtlasSize[0] * atlas->auAtlasSize[1] * 4);
+
+        memset(atlas->pucPixelsAsAlpha8, 0, atlas->auAtlasSize[0] * atlas->auAtlasSize[1]);
+        if(atlas->pucPixelsAsRGBA32)
+            memset(atlas->pucPixelsAsRGBA32, 0, atlas->auAtlasSize[0] * atlas->auAtlasSize[1] * 4);
+        atlas->_bBorrowedPixels = false;
+    }
+    else if(atlas->bAlpha8Only && atlas->pucPixelsAsRGBA32)
+    {
+        pl_memory_free(atlas->pucPixelsAsRGBA32);
+        atlas->pucPixelsAsRGBA32 = NULL;
+    }
+    spc.pixels = atlas->pucPixelsAsAlpha8;
+    atlas->szPixelDataSize = atlas->auAtlasSize[0] * atlas->auAtlasSize[1];
+
+    // rasterize bitmap fonts (one job per range)
+    plFontRasterRange* sbtRasterRanges = NULL;
+    for(uint32_t i = 0u; i < plu_sb_size(atlas->_sbtPrepData); i++)
+    {
+        plFont* font = atlas->sbtFonts[i];
+        plFontPrepData* prep = &atlas->_sbtPrepData[i];
+        if(font->tConfig.bSdf)
+            continue;
+
+        uint32_t uRectOffset = 0u;
+        for(uint32_t j = 0u; j < plu_sb_size(font->tConfig.sbtRanges); j++)
+        {
+            plFontRasterRange tRange = {
+                .ptPrep  = prep,
+                .ptRange = &prep->ranges[j],
+                .ptRects = &prep->rects[uRectOffset]
+            };
+            plu_sb_push(sbtRasterRanges, tRange);
+            uRectOffset += (uint32_t)prep->ranges[j].num_chars;
+        }
+    }
+
+    plAtlasBuildJob tBuildJob = {
+        .ptAtlas       = atlas,
+        .ptPackContext = &spc,
+        .atRanges      = sbtRasterRanges
+    };
+    pl__dispatch_jobs(pl__rasterize_font_range, &tBuildJob, plu_sb_size(sbtRasterRanges), NULL);
+    plu_sb_free(sbtRasterRanges);
+
+    // update SDF/custom data
+    for(uint32_t i = 0u; i < plu_sb_size(atlas->sbtCustomRects); i++)
+    {
+        atlas->sbtCustomRects[i].uX = (uint32_t)rects[i].x;
+        atlas->sbtCustomRects[i].uY = (uint32_t)rects[i].y;
+    }
+
+    uint32_t charDataOffset = 0u;
+    for(uint32_t fontIndex = 0u; fontIndex < plu_sb_size(atlas->sbtFonts); fontIndex++)
+    {
+        plFont* font = atlas->sbtFonts[fontIndex];
+        if(font->tConfig.bSdf)
+        {
+            for(uint32_t i = 0u; i < plu_sb_size(font->sbtCharData); i++)
+            {
+                font->sbtCharData[i].x0 = (uint16_t)rects[charDataOffset + i].x;
+                font->sbtCharData[i].y0 = (uint16_t)rects[charDataOffset + i].y;
+                font->sbtCharData[i].x1 = (uint16_t)(rects[charDataOffset + i].x + atlas->sbtCustomRects[charDataOffset + i].uWidth);
+                font->sbtCharData[i].y1 = (uint16_t)(rects[charDataOffset + i].y + atlas->sbtCustomRects[charDataOffset + i].uHeight);
+                
+            }
+            charDataOffset += plu_sb_size(font->sbtCharData);  
+        }
+    }
+
+    // packing state is kept for pl_update_font_atlas
+    atlas->_ptPacker = pl_memory_alloc(sizeof(plFontPacker));
+    atlas->_ptPacker->tContext = spc;
+
+    // rasterize SDF/custom rects
+    const uint32_t uCustomRectCount = plu_sb_size(atlas->sbtCustomRects);
+    pl__dispatch_jobs(pl__blit_custom_rects, &tBuildJob, (uCustomRectCount + PL_UI_ATLAS_RECTS_PER_JOB - 1) / PL_UI_ATLAS_RECTS_PER_JOB, NULL);
+
+    // update white point uvs
+    atlas->afWhiteUv[0] = (float)(atlas->ptWhiteRect->uX + atlas->ptWhiteRect->uWidth / 2) / (float)atlas->auAtlasSize[0];
+    atlas->afWhiteUv[1] = (float)(atlas->ptWhiteRect->uY + atlas->ptWhiteRect->uHeight / 2) / (float)atlas->auAtlasSize[1];
+
+    // add glyphs
+    for(uint32_t fontIndex = 0u; fontIndex < plu_sb_size(atlas->sbtFonts); fontIndex++)
+        pl__add_font_glyphs(atlas, fontIndex);
+    atlas->_uBuiltFontCount = plu_sb_size(atlas->sbtFonts);
+
+    // convert to 4 color channels
+    if(atlas->pucPixelsAsRGBA32)
+        pl__dispatch_jobs(pl__expand_atlas_alpha, &tBuildJob, (atlas->auAtlasSize[1] + PL_UI_ATLAS_ROWS_PER_JOB - 1) / PL_UI_ATLAS_ROWS_PER_JOB, NULL);
+
+    pl_memory_free(rects);
+
+    if(atlas->pcCacheFile && !bHasDynamicFonts)
+        pl__save_font_atlas_cache(atlas);
+}
+
+bool
+pl_update_font_atlas(plFontAtlas* atlas)
+{
+    // nothing to add to yet
+    if(atlas->pucPixelsAsAlpha8 == NULL)
+    {
+        pl_build_font_atlas(atlas);
+        return true;
+    }
+
+    const uint32_t uFirstFont = atlas->_uBuiltFontCount;
+    const uint32_t uFontCount = plu_sb_size(atlas->sbtFonts);
+    if(uFirstFont == uFontCount)
+        return false;
+
+    // cached layouts are keyed by font pointer, drop them like a full build does
+    if(gptCtx)
+        pl__invalidate_text_cache();
+
+    // cached & baked atlases come without a skyline, so everything already
+    // there is treated as a single full width rect
+    if(atlas->_ptPacker == NULL)
+    {
+        atlas->_ptPacker = pl_memory_alloc(sizeof(plFontPacker));
+        stbtt_PackBegin(&atlas->_ptPacker->tContext, NULL, atlas->auAtlasSize[0], 1024 * 32, 0, atlas->iGlyphPadding, NULL);
+        stbrp_rect tUsed = {
+            .w = (stbrp_coord)(atlas->auAtlasSize[0] - (uint32_t)atlas->iGlyphPadding), // packer width
+            .h = (stbrp_coord)atlas->auAtlasSize[1]
+        };
+        stbrp_pack_rects((stbrp_context*)atlas->_ptPacker->tContext.pack_info, &tUsed, 1);
+    }
+    stbtt_pack_context* ptSpc = &atlas->_ptPacker->tContext;
+    stbrp_context* ptRectPacker = (stbrp_context*)ptSpc->pack_info;
+
+    // per glyph work for the new fonts only (SDF fonts append custom rects)
+    const uint32_t uWhiteRect = (uint32_t)(atlas->ptWhiteRect - atlas->sbtCustomRects);
+    const uint32_t uFirstCustomRect = plu_sb_size(atlas->sbtCustomRects);
+    bool bAddsDynamicFonts = false;
+    for(uint32_t i = uFirstFont; i < uFontCount; i++)
+    {
+        pl__prepare_font(atlas, atlas->sbtFonts[i], &atlas->_sbtPrepData[i]);
+        bAddsDynamicFonts |= atlas->sbtFonts[i]->tConfig.bDynamic;
+    }
+    atlas->ptWhiteRect = &atlas->sbtCustomRects[uWhiteRect];
+
+    // pack into the space left free, growing the atlas only when nothing fits
+    uint32_t uHeight = atlas->auAtlasSize[1];
+    uint32_t uDirtyMinY = UINT32_MAX;
+    uint32_t uDirtyMaxY = 0u;
+    for(uint32_t i = uFirstFont; i < uFontCount; i++)
+    {
+        plFont* font = atlas->sbtFonts[i];
+        if(font->tConfig.bSdf || font->tConfig.bDynamic)
+            continue;
+        plFontPrepData* prep = &atlas->_sbtPrepData[i];
+        stbtt_PackSetOversampling(ptSpc, font->tConfig.uHOverSampling, font->tConfig.uVOverSampling);
+        stbrp_pack_rects(ptRectPacker, prep->rects, prep->uTotalCharCount);
+        for(uint32_t j = 0u; j < prep->uTotalCharCount; j++)
+        {
+            const stbrp_rect* ptRect = &prep->rects[j];
+            if(!ptRect->was_packed || ptRect->h == 0)
+                continue;
+            uHeight = plu_max(uHeight, (uint32_t)(ptRect->y + ptRect->h));
+            uDirtyMinY = plu_min(uDirtyMinY, (uint32_t)ptRect->y);
+            uDirtyMaxY = plu_max(uDirtyMaxY, (uint32_t)(ptRect->y + ptRect->h));
+        }
+    }
+
+    const uint32_t uNewCustomRectCount = plu_sb_size(atlas->sbtCustomRects) - uFirstCustomRect;
+    if(uNewCustomRectCount > 0)
+    {
+        stbrp_rect* rects = pl_memory_alloc(sizeof(stbrp_rect) * uNewCustomRectCount);
+        memset(rects, 0, sizeof(stbrp_rect) * uNewCustomRectCount);
+        for(uint32_t i = 0u; i < uNewCustomRectCount; i++)
+        {
+            rects[i].w = (int)atlas->sbtCustomRects[uFirstCustomRect + i].uWidth;
+            rects[i].h = (int)atlas->sbtCustomRects[uFirstCustomRect + i].uHeight;
+        }
+        stbtt_PackSetOversampling(ptSpc, 1, 1);
+        stbrp_pack_rects(ptRectPacker, rects, uNewCustomRectCount);
+        for(uint32_t i = 0u; i < uNewCustomRectCount; i++)
+        {
+            atlas->sbtCustomRects[uFirstCustomRect + i].uX = (uint32_t)rects[i].x;
+            atlas->sbtCustomRects[uFirstCustomRect + i].uY = (uint32_t)rects[i].y;
+            if(!rects[i].was_packed || rects[i].h == 0)
+                continue;
+            uHeight = plu_max(uHeight, (uint32_t)(rects[i].y + rects[i].h));
+            uDirtyMinY = plu_min(uDirtyMinY, (uint32_t)rects[i].y);
+            uDirtyMaxY = plu_max(uDirtyMaxY, (uint32_t)(rects[i].y + rects[i].h));
+        }
+        pl_memory_free(rects);
+    }
+
+    // SDF char data points at the font's custom rects
+    uint32_t uCustomRect = uFirstCustomRect;
+    for(uint32_t i = uFirstFont; i < uFontCount; i++)
+    {
+        plFont* font = atlas->sbtFonts[i];
+        if(!font->tConfig.bSdf || font->tConfig.bDynamic)
+            continue;
+        for(uint32_t j = 0u; j < plu_sb_size(font->sbtCharData); j++)
+        {
+            const plFontCustomRect* ptCustomRect = &atlas->sbtCustomRects[uCustomRect + j];
+            font->sbtCharData[j].x0 = (uint16_t)ptCustomRect->uX;
+            font->sbtCharData[j].y0 = (uint16_t)ptCustomRect->uY;
+            font->sbtCharData[j].x1 = (uint16_t)(ptCustomRect->uX + ptCustomRect->uWidth);
+            font->sbtCharData[j].y1 = (uint16_t)(ptCustomRect->uY + ptCustomRect->uHeight);
+        }
+        uCustomRect += plu_sb_size(font->sbtCharData);
+    }
+
+    // first dynamic font needs a region of its own
+    if(bAddsDynamicFonts && atlas->_uDynamicEndY == atlas->_uDynamicY)
+    {
+        stbrp_rect tRegion = {
+            .w = (stbrp_coord)(atlas->auAtlasSize[0] - (uint32_t)atlas->iGlyphPadding), // packer width
+            .h = (stbrp_coord)(atlas->iGlyphPadding + (atlas->uDynamicHeight > 0 ? atlas->uDynamicHeight : PL_UI_ATLAS_DYNAMIC_HEIGHT))
+        };
+        stbrp_pack_rects(ptRectPacker, &tRegion, 1);
+        atlas->_uDynamicY = (uint32_t)tRegion.y + (uint32_t)atlas->iGlyphPadding;
+        atlas->_uDynamicEndY = (uint32_t)(tRegion.y + tRegion.h);
+        uHeight = plu_max(uHeight, atlas->_uDynamicEndY);
+    }
+
+    // a new texture size means new backend texture (which gets a full upload)
+    const bool bRecreateTexture = pl__grow_font_atlas(atlas, uHeight);
+    ptSpc->pixels = atlas->pucPixelsAsAlpha8;
+
+    // rasterize new bitmap fonts (one job per range)
+    plFontRasterRange* sbtRasterRanges = NULL;
+    for(uint32_t i = uFirstFont; i < uFontCount; i++)
+    {
+        plFont* font = atlas->sbtFonts[i];
+        plFontPrepData* prep = &atlas->_sbtPrepData[i];
+        if(font->tConfig.bSdf)
+            continue;
+
+        uint32_t uRectOffset = 0u;
+        for(uint32_t j = 0u; j < plu_sb_size(font->tConfig.sbtRanges); j++)
+        {
+            plFontRasterRange tRange = {
+                .ptPrep  = prep,
+                .ptRange = &prep->ranges[j],
+                .ptRects = &prep->rects[uRectOffset]
+            };
+            plu_sb_push(sbtRasterRanges, tRange);
+            uRectOffset += (uint32_t)prep->ranges[j].num_chars;
+        }
+    }
+
+    plAtlasBuildJob tBuildJob = {
+        .ptAtlas          = atlas,
+        .ptPackContext    = ptSpc,
+        .atRanges         = sbtRasterRanges,
+        .uFirstCustomRect = uFirstCustomRect
+    };
+    pl__dispatch_jobs(pl__rasterize_font_range, &tBuildJob, plu_sb_size(sbtRasterRanges), NULL);
+    plu_sb_free(sbtRasterRanges);
+
+    // blit new SDF/custom rects
+    pl__dispatch_jobs(pl__blit_custom_rects, &tBuildJob, (uNewCustomRectCount + PL_UI_ATLAS_RECTS_PER_JOB - 1) / PL_UI_ATLAS_RECTS_PER_JOB, NULL);
+
+    // add glyphs
+    for(uint32_t i = uFirstFont; i < uFontCount; i++)
+        pl__add_font_glyphs(atlas, i);
+    atlas->_uBuiltFontCount = uFontCount;
+
+    // rows holding new glyphs (also brings the RGBA copy up to date)
+    if(uDirtyMinY < uDirtyMaxY)
+        pl__add_atlas_dirty_rect(atlas, 0u, uDirtyMinY, atlas->auAtlasSize[0], uDirtyMaxY - uDirtyMinY);
+    if(bRecreateTexture)
+        plu_sb_reset(atlas->sbtDirtyRects);
+    return bRecreateTexture;
+}
+
+void
+pl_cleanup_font_atlas(plFontAtlas* atlas)
+{
+    if(gptCtx)
+        pl__invalidate_text_cache();
+
+    for(uint32_t i = 0; i < plu_sb_size(atlas->sbtFonts); i++)
+    {
+        plFont* font = atlas->sbtFonts[i];
+        plu_sb_free(font->tConfig.sbtRanges);
+        plu_sb_free(font->tConfig.sbiIndividualChars);
+        plu_sb_free(font->sbuCodePointPages);
+        plu_sb_free(font->sbuCodePoints);
+        plu_sb_free(font->sbtGlyphs);
+        plu_sb_free(font->sbtCharData);
+        plu_sb_free(font->_sbuGlyphShelves);
+        plu_sb_free(font->_sbuGlyphCodePoints);
+        plu_sb_free(font->_sbuFreeGlyphs);
+        if(font->_ptAsciiTable)
+        {
+            pl_memory_free(font->_ptAsciiTable);
+            font->_ptAsciiTable = NULL;
+        }
+        pl_memory_free(font);
+    }
+    for(uint32_t i = 0; i < plu_sb_size(atlas->_sbtPrepData); i++)
+    {
+        // never prepared when the atlas came from the cache
+        if(atlas->_sbtPrepData[i].ranges) pl_memory_free(atlas->_sbtPrepData[i].ranges);
+        if(atlas->_sbtPrepData[i].rects)  pl_memory_free(atlas->_sbtPrepData[i].rects);
+        pl__release_font_data(&atlas->_sbtPrepData[i]);
+    }
+    for(uint32_t i = 0; i < plu_sb_size(atlas->sbtCustomRects); i++)
+    {
+        pl_memory_free(atlas->sbtCustomRects[i].pucBytes);
+    }
+    plu_sb_free(atlas->sbtCustomRects);
+    plu_sb_free(atlas->sbtFonts);
+    plu_sb_free(atlas->_sbtPrepData);
+    plu_sb_free(atlas->sbtDirtyRects);
+    plu_sb_free(atlas->_sbtShelves);
+    pl__free_font_packer(atlas);
+    if(!atlas->_bBorrowedPixels)
+        pl_memory_free(atlas->pucPixelsAsAlpha8);
+    if(atlas->pucPixelsAsRGBA32)
+        pl_memory_free(atlas->pucPixelsAsRGBA32);
+}
+
+bool
+pl_save_font_atlas_source(const plFontAtlas* atlas, const char* file, const char* name)
+{
+    FILE* ptFile = fopen(file, "w");
+    if(ptFile == NULL)
+        return false;
+
+    size_t szSize = 0;
+    unsigned char* pucData = pl__serialize_font_atlas(atlas, &szSize);
+
+    fprintf(ptFile, "// generated by pl_save_font_atlas_source(), do not edit\n");
+    fprintf(ptFile, "// %u x %u atlas, %u font(s)\n\n", atlas->auAtlasSize[0], atlas->auAtlasSize[1], plu_sb_size(atlas->sbtFonts));
+    fprintf(ptFile, "static const unsigned char %s[%zu] =\n{", name, szSize);
+    for(size_t i = 0; i < szSize; i++)
+        fprintf(ptFile, "%s0x%02x,", (i % 16 == 0) ? "\n    " : "", pucData[i]);
+    fprintf(ptFile, "\n};\n");
+    fclose(ptFile);
+
+    pl_memory_free(pucData);
+    return true;
+}
+
+static void
+pl__prepare_draw_command(plDrawLayer* ptLayer, plTextureId textureID, bool sdf)
+{
+    bool createNewCommand = true;
+
+    // layer stack first so worker filled layers never touch the shared drawlist stack
+    const plRect* ptCurrentClip = pl_get_layer_clip_rect(ptLayer);
+    const plRect tCurrentClip = ptCurrentClip ? *ptCurrentClip : (plRect){0};
+
+    
+    if(ptLayer->_ptLastCommand)
+    {
+        // check if last command has same texture
+        if(ptLayer->_ptLastCommand->tTextureId == textureID && ptLayer->_ptLastCommand->bSdf == sdf)
+        {
+            createNewCommand = false;
+        }
+
+        // check if last command has same clipping
+        if(ptLayer->_ptLastCommand->tClip.tMax.x != tCurrentClip.tMax.x || ptLayer->_ptLastCommand->tClip.tMax.y != tCurrentClip.tMax.y ||
+            ptLayer->_ptLastCommand->tClip.tMin.x != tCurrentClip.tMin.x || ptLayer->_ptLastCommand->tClip.tMin.y != tCurrentClip.tMin.y)
+        {
+            createNewCommand = true;
+        }
+    }
+
+    // new command needed
+    if(createNewCommand)
+    {
+        plDrawCommand newdrawCommand = 
+        {
+            .uVertexOffset = plu_sb_size(ptLayer->sbtVertexBuffer),
+            .uIndexOffset  = plu_sb_size(ptLayer->sbuIndexBuffer),
+            .uElementCount = 0u,
+            .tTextureId    = textureID,
+            .bSdf          = sdf,
+            .tClip        = tCurrentClip
+        };
+        plu_sb_push(ptLayer->sbtCommandBuffer, newdrawCommand);
+        
+    }
+    ptLayer->_ptLastCommand = &plu_sb_top(ptLayer->sbtCommandBuffer);
+    ptLayer->_ptLastCommand->tTextureId = textureID;
+}
+
+static void
+pl__reserve_triangles(plDrawLayer* ptLayer, uint32_t indexCount, uint32_t uVertexCount)
+{
+    plu_sb_reserve(ptLayer->sbtVertexBuffer, plu_sb_size(ptLayer->sbtVertexBuffer) + uVertexCount);
+    plu_sb_reserve(ptLayer->sbuIndexBuffer, plu_sb_size(ptLayer->sbuIndexBuffer) + indexCount);
+    ptLayer->_ptLastCommand->uElementCount += indexCount; 
+    ptLayer->uVertexCount += uVertexCount;
+}
+
+static void
+pl__add_vertex(plDrawLayer* ptLayer, plVec2 pos, uint32_t uColor, plVec2 uv)
+{
+
+    plu_sb_push(ptLayer->sbtVertexBuffer,
+        ((plDrawVertex){
+            .afPos[0] = pos.x,
+            .afPos[1] = pos.y,
+            .afUv[0] = uv.u,
+            .afUv[1] = uv.v,
+            .uColor = uColor
+        })
+    );
+}
+
+static void
+pl__add_index(plDrawLayer* ptLayer, uint32_t vertexStart, uint32_t i0, uint32_t i1, uint32_t i2)
+{
+    plu_sb_push(ptLayer->sbuIndexBuffer, vertexStart + i0);
+    plu_sb_push(ptLayer->sbuIndexBuffer, vertexStart + i1);
+    plu_sb_push(ptLayer->sbuIndexBuffer, vertexStart + i2);
+}
+
+static void
+pl__stroke_polyline(plDrawLayer* ptLayer, const plVec2* atPoints, uint32_t uPointCount, uint32_t uColor, float fThickness, bool bClosed)
+{
+    if(uPointCount < 2)
+        return;
+
+    const uint32_t uSegmentCount = bClosed ? uPointCount : uPointCount - 1;
+    const float    fHalfThickness = fThickness * 0.5f;
+    const plVec2   tWhiteUv = {gptCtx->fontAtlas->afWhiteUv[0], gptCtx->fontAtlas->afWhiteUv[1]};
+
+    pl__prepare_draw_command(ptLayer, gptCtx->fontAtlas->tTexture, false);
+
+    // worst case every point is a bevel join (3 vertices + 1 extra triangle)
+    const uint32_t uVtxStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    const uint32_t uIdxStart = plu_sb_size(ptLayer->sbuIndexBuffer);
+    plu_sb_reserve(ptLayer->sbtVertexBuffer, uVtxStart + uPointCount * 3);
+    plu_sb_reserve(ptLayer->sbuIndexBuffer, uIdxStart + uSegmentCount * 6 + uPointCount * 3);
+    plDrawVertex* ptVtxWrite = &ptLayer->sbtVertexBuffer[uVtxStart];
+    uint32_t*     puIdxWrite = &ptLayer->sbuIndexBuffer[uIdxStart];
+    uint32_t      uVtxCurrent = uVtxStart;
+
+    // vertex pairs (left = +normal side, right = -normal side) where
+    // the previous segment ended & the first segment starts
+    uint32_t uPrevOutL = 0;
+    uint32_t uPrevOutR = 0;
+    uint32_t uFirstInL = 0;
+    uint32_t uFirstInR = 0;
+
+    for(uint32_t i = 0; i < uPointCount; i++)
+    {
+        const plVec2 tP = atPoints[i];
+        // normals of the incoming & outgoing segments
+        plVec2 tNormalIn = {0};
+        plVec2 tNormalOut = {0};
+        if(bClosed || i > 0)
+        {
+            const plVec2 tPrev = atPoints[i == 0 ? uPointCount - 1 : i - 1];
+            float dx = tP.x - tPrev.x;
+            float dy = tP.y - tPrev.y;
+            PL_NORMALIZE2F_OVER_ZERO(dx, dy);
+            tNormalIn = (plVec2){dy, -dx};
+        }
+        if(bClosed || i < uPointCount - 1)
+        {
+            const plVec2 tNext = atPoints[i == uPointCount - 1 ? 0 : i + 1];
+            float dx = tNext.x - tP.x;
+            float dy = tNext.y - tP.y;
+            PL_NORMALIZE2F_OVER_ZERO(dx, dy);
+            tNormalOut = (plVec2){dy, -dx};
+        }
+        // butt caps at open ends (zero length segments are treated the same way)
+        if(tNormalIn.x == 0.0f && tNormalIn.y == 0.0f)   tNormalIn = tNormalOut;
+        if(tNormalOut.x == 0.0f && tNormalOut.y == 0.0f) tNormalOut = tNormalIn;
+
+        float mx = tNormalIn.x + tNormalOut.x;
+        float my = tNormalIn.y + tNormalOut.y;
+        PL_NORMALIZE2F_OVER_ZERO(mx, my);
+        const float fCosHalfAngle = mx * tNormalIn.x + my * tNormalIn.y;
+
+        uint32_t uInL, uInR, uOutL, uOutR;
+        if(fCosHalfAngle * PL_UI_MITER_LIMIT >= 1.0f) // miter (both segments share the pair)
+        {
+            const float fMiter = fHalfThickness / fCosHalfAngle;
+            ptVtxWrite[0] = (plDrawVertex){ .afPos = {tP.x + mx * fMiter, tP.y + my * fMiter}, .afUv = {tWhiteUv.x, tWhiteUv.y}, .uColor = uColor };
+            ptVtxWrite[1] = (plDrawVertex){ .afPos = {tP.x - mx * fMiter, tP.y - my * fMiter}, .afUv = {tWhiteUv.x, tWhiteUv.y}, .uColor = uColor };
+            ptVtxWrite += 2;
+            uInL = uOutL = uVtxCurrent;
+            uInR = uOutR = uVtxCurrent + 1;
+            uVtxCurrent += 2;
+        }
+        else // bevel (outer side gets a vertex per segment, inner side shares a limited miter)
+        {
+            const float fInner = fHalfThickness * PL_UI_MITER_LIMIT;
+            const float fSign = (tNormalIn.x * tNormalOut.y - tNormalIn.y * tNormalOut.x) > 0.0f ? 1.0f : -1.0f; // +1 if left side is outer
+            const plVec2 tInner    = {tP.x - fSign * mx * fInner, tP.y - fSign * my * fInner};
+            const plVec2 tOuterIn  = {tP.x + fSign * tNormalIn.x * fHalfThickness, tP.y + fSign * tNormalIn.y * fHalfThickness};
+            const plVec2 tOuterOut = {tP.x + fSign * tNormalOut.x * fHalfThickness, tP.y + fSign * tNormalOut.y * fHalfThickness};
+            ptVtxWrite[0] = (plDrawVertex){ .afPos = {tInner.x, tInner.y},       .afUv = {tWhiteUv.x, tWhiteUv.y}, .uColor = uColor };
+            ptVtxWrite[1] = (plDrawVertex){ .afPos = {tOuterIn.x, tOuterIn.y},   .afUv = {tWhiteUv.x, tWhiteUv.y}, .uColor = uColor };
+            ptVtxWrite[2] = (plDrawVertex){ .afPos = {tOuterOut.x, tOuterOut.y}, .afUv = {tWhiteUv.x, tWhiteUv.y}, .uColor = uColor };
+            ptVtxWrite += 3;
+
+            if(fSign > 0.0f)
+            {
+                uInL = uVtxCurrent + 1; uOutL = uVtxCurrent + 2;
+                uInR = uOutR = uVtxCurrent;
+            }
+            else
+            {
+                uInR = uVtxCurrent + 1; uOutR = uVtxCurrent + 2;
+                uInL = uOutL = uVtxCurrent;
+            }
+
+            puIdxWrite[0] = uVtxCurrent;
+            puIdxWrite[1] = uVtxCurrent + 1;
+            puIdxWrite[2] = uVtxCurrent + 2;
+            puIdxWrite += 3;
+            uVtxCurrent += 3;
+        }
+
+        if(i == 0)
+        {
+            uFirstInL = uInL;
+            uFirstInR = uInR;
+        }
+        else
+        {
+            puIdxWrite[0] = uPrevOutL;
+            puIdxWrite[1] = uPrevOutR;
+            puIdxWrite[2] = uInR;
+            puIdxWrite[3] = uPrevOutL;
+            puIdxWrite[4] = uInR;
+            puIdxWrite[5] = uInL;
+            puIdxWrite += 6;
+        }
+        uPrevOutL = uOutL;
+        uPrevOutR = uOutR;
+    }
+
+    if(bClosed)
+    {
+        puIdxWrite[0] = uPrevOutL;
+        puIdxWrite[1] = uPrevOutR;
+        puIdxWrite[2] = uFirstInR;
+        puIdxWrite[3] = uPrevOutL;
+        puIdxWrite[4] = uFirstInR;
+        puIdxWrite[5] = uFirstInL;
+        puIdxWrite += 6;
+    }
+
+    // commit what was actually written
+    const uint32_t uVtxWritten = uVtxCurrent - uVtxStart;
+    const uint32_t uIdxWritten = (uint32_t)(puIdxWrite - &ptLayer->sbuIndexBuffer[uIdxStart]);
+    plu__sb_header(ptLayer->sbtVertexBuffer)->uSize += uVtxWritten;
+    plu__sb_header(ptLayer->sbuIndexBuffer)->uSize += uIdxWritten;
+    ptLayer->_ptLastCommand->uElementCount += uIdxWritten;
+    ptLayer->uVertexCount += uVtxWritten;
+}
+
+static void
+pl__measure_text(plFont* ptFont, float fSize, const char* pcText, const char* pcTextEnd, float fWrap, plVec2* ptMinOut, plVec2* ptMaxOut)
+{
+    const float fScale = fSize > 0.0f ? fSize / ptFont->tConfig.fFontSize : 1.0f;
+
+    plTextMeasure tMeasure = {
+        .tMin            = {FLT_MAX, FLT_MAX},
+        .fScale          = fScale,
+        .fLineSpacing    = fScale * ptFont->fLineSpacing,
+        .fWrap           = fWrap,
+        .bFirstCharacter = true
+    };
+
+    const plFontAsciiTable* ptAscii = ptFont->_ptAsciiTable;
+
+    while(pcText < pcTextEnd)
+    {
+        // ASCII runs read the dense tables directly (no decode or page lookup)
+        if(ptAscii)
+        {
+            const char* pcRunEnd = pl__ascii_run_end(pcText, pcTextEnd);
+            for(; pcText < pcRunEnd; pcText++)
+            {
+                const uint32_t c = (uint32_t)*pcText;
+                if(c == '\n')
+                {
+                    tMeasure.tCursor.x = tMeasure.tMin.x;
+                    tMeasure.tCursor.y += tMeasure.fLineSpacing;
+                }
+                else if(c != '\r' && ptAscii->auGlyph[c] != PL__GLYPH_NOT_FOUND)
+                    pl__measure_glyph(&tMeasure, ptAscii->afX0[c], ptAscii->afY0[c], ptAscii->afX1[c], ptAscii->afY1[c], ptAscii->afXAdvance[c], ptAscii->afLeftBearing[c]);
+            }
+            if(pcText >= pcTextEnd)
+                break;
+        }
+
+        uint32_t c = (uint32_t)*pcText;
+        if(c < 0x80)
+            pcText += 1;
+        else
+        {
+            pcText += plu_text_char_from_utf8(&c, pcText, NULL);
+            if(c == 0) // malformed UTF-8?
+                break;
+        }
+
+        if(c == '\n')
+        {
+            tMeasure.tCursor.x = tMeasure.tMin.x;
+            tMeasure.tCursor.y += tMeasure.fLineSpacing;
+        }
+        else if(c != '\r')
+        {
+            const plFontGlyph* ptGlyph = pl__find_glyph(ptFont, c);
+            if(ptGlyph) // otherwise not loaded into this font
+                pl__measure_glyph(&tMeasure, ptGlyph->x0, ptGlyph->y0, ptGlyph->x1, ptGlyph->y1, ptGlyph->xAdvance, ptGlyph->leftBearing);
+        }
+    }
+
+    *ptMinOut = tMeasure.tMin;
+    *ptMaxOut = tMeasure.tMax;
+}
+
+static void
+pl__add_text_run(plDrawLayer* ptLayer, plFont* font, float size, plVec2 p, plVec4 color, const char* text, const char* pcTextEnd, float wrap, const plRect* ptClipRect)
+{
+    float scale = size > 0.0f ? size / font->tConfig.fFontSize : 1.0f;
+
+    float fLineSpacing = scale * font->fLineSpacing;
+    const plVec2 originalPosition = p;
+    bool firstCharacter = true;
+
+    // a run never emits more glyphs than it has bytes, so reserve once
+    // and write through raw pointers instead of pushing per vertex
+    const uint32_t uMaxGlyphs = (uint32_t)(pcTextEnd - text);
+    const uint32_t uVtxStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    const uint32_t uIdxStart = plu_sb_size(ptLayer->sbuIndexBuffer);
+    plu_sb_reserve(ptLayer->sbtVertexBuffer, uVtxStart + uMaxGlyphs * 4);
+    plu_sb_reserve(ptLayer->sbuIndexBuffer, uIdxStart + uMaxGlyphs * 6);
+    plDrawVertex* ptVtxWrite = &ptLayer->sbtVertexBuffer[uVtxStart];
+    uint32_t*     puIdxWrite = &ptLayer->sbuIndexBuffer[uIdxStart];
+    uint32_t      uVtxCurrent = uVtxStart;
+
+    const uint32_t tColor = plu_pack_color(color);
+    bool bCommandPrepared = false;
+
+    // ASCII runs index the glyphs directly (no decode or page lookup)
+    const plFontAsciiTable* ptAscii = font->_ptAsciiTable;
+    const char* pcAsciiEnd = text;
+
+    while(text < pcTextEnd)
+    {
+        uint32_t c = (uint32_t)*text;
+        const plFontGlyph* glyph = NULL;
+        if(text < pcAsciiEnd)
+        {
+            text += 1;
+            if(ptAscii->auGlyph[c] != PL__GLYPH_NOT_FOUND)
+                glyph = &font->sbtGlyphs[ptAscii->auGlyph[c]];
+        }
+        else if(ptAscii && (pcAsciiEnd = pl__ascii_run_end(text, pcTextEnd)) != text)
+            continue;
+        else
+        {
+            if(c < 0x80)
+                text += 1;
+            else
+            {
+                text += plu_text_char_from_utf8(&c, text, NULL);
+                if(c == 0) // malformed UTF-8?
+                    break;
+            }
+            if(c != '\n' && c != '\r')
+                glyph = pl__find_glyph(font, c);
+        }
+
+        if(c == '\n')
+        {
+            p.x = originalPosition.x;
+            p.y += fLineSpacing;
+        }
+        else if(c == '\r')
+        {
+            // do nothing
+        }
+        else
+        {
+            if(glyph == NULL) // not loaded into this font
+                continue;
+
+            float x0,y0,s0,t0; // top-left
+            float x1,y1,s1,t1; // bottom-right
+
+            // adjust for left side bearing if first char
+            if(firstCharacter)
+            {
+                if(glyph->leftBearing > 0.0f) p.x += glyph->leftBearing * scale;
+                firstCharacter = false;
+            }
+
+            x0 = p.x + glyph->x0 * scale;
+            x1 = p.x + glyph->x1 * scale;
+            y0 = p.y + glyph->y0 * scale;
+            y1 = p.y + glyph->y1 * scale;
+
+            if(wrap > 0.0f && x1 > originalPosition.x + wrap)
+            {
+                x0 = originalPosition.x + glyph->x0 * scale;
+                y0 = y0 + fLineSpacing;
+                x1 = originalPosition.x + glyph->x1 * scale;
+                y1 = y1 + fLineSpacing;
+
+                p.x = originalPosition.x;
+                p.y += fLineSpacing;
+            }
+            s0 = glyph->u0;
+            t0 = glyph->v0;
+            s1 = glyph->u1;
+            t1 = glyph->v1;
+
+            p.x += glyph->xAdvance * scale;
+            if(c != ' ' && (ptClipRect == NULL || plu_rect_contains_point(ptClipRect, p)))
+            {
+                // texture & clip are constant for the run
+                if(!bCommandPrepared)
+                {
+                    pl__prepare_draw_command(ptLayer, font->ptParentAtlas->tTexture, font->tConfig.bSdf);
+                    bCommandPrepared = true;
+                }
+
+                ptVtxWrite[0] = (plDrawVertex){ .afPos = {x0, y0}, .afUv = {s0, t0}, .uColor = tColor };
+                ptVtxWrite[1] = (plDrawVertex){ .afPos = {x1, y0}, .afUv = {s1, t0}, .uColor = tColor };
+                ptVtxWrite[2] = (plDrawVertex){ .afPos = {x1, y1}, .afUv = {s1, t1}, .uColor = tColor };
+                ptVtxWrite[3] = (plDrawVertex){ .afPos = {x0, y1}, .afUv = {s0, t1}, .uColor = tColor };
+                ptVtxWrite += 4;
+
+                puIdxWrite[0] = uVtxCurrent + 1;
+                puIdxWrite[1] = uVtxCurrent;
+                puIdxWrite[2] = uVtxCurrent + 2;
+                puIdxWrite[3] = uVtxCurrent + 2;
+                puIdxWrite[4] = uVtxCurrent;
+                puIdxWrite[5] = uVtxCurrent + 3;
+                puIdxWrite += 6;
+                uVtxCurrent += 4;
+            }
+        }   
+    }
+
+    // commit what was actually written
+    const uint32_t uVtxWritten = uVtxCurrent - uVtxStart;
+    const uint32_t uIdxWritten = uVtxWritten / 4 * 6;
+    if(uVtxWritten > 0)
+    {
+        plu__sb_header(ptLayer->sbtVertexBuffer)->uSize += uVtxWritten;
+        plu__sb_header(ptLayer->sbuIndexBuffer)->uSize += uIdxWritten;
+        ptLayer->_ptLastCommand->uElementCount += uIdxWritten;
+        ptLayer->uVertexCount += uVtxWritten;
+    }
+}
+
+const plUiTextLayout*
+pl__get_text_layout(plFont* ptFont, float fSize, const char* pcText, const char* pcTextEnd, float fWrap)
+{
+    if(fWrap <= 0.0f)
+        fWrap = 0.0f;
+
+    const uint32_t uTextLength = (uint32_t)(pcTextEnd - pcText);
+    uint32_t uHash = plu_str_hash_data(&ptFont, sizeof(plFont*), 0);
+    uHash = plu_str_hash_data(&fSize, sizeof(float), uHash);
+    uHash = plu_str_hash_data(&fWrap, sizeof(float), uHash);
+    uHash = plu_str_hash_data(pcText, uTextLength, uHash);
+
+    gptCtx->ulTextCacheTick++;
+
+    // search set, remembering the least recently used way
+    plUiTextLayout* ptSet = &gptCtx->atTextCache[(uHash & (PL_UI_TEXT_CACHE_SETS - 1)) * PL_UI_TEXT_CACHE_WAYS];
+    plUiTextLayout* ptLayout = &ptSet[0];
+    for(uint32_t i = 0; i < PL_UI_TEXT_CACHE_WAYS; i++)
+    {
+        plUiTextLayout* ptCandidate = &ptSet[i];
+        if(ptCandidate->ptFont == ptFont && ptCandidate->uHash == uHash && ptCandidate->uTextLength == uTextLength
+            && ptCandidate->fSize == fSize && ptCandidate->fWrap == fWrap
+            && (uTextLength == 0 || memcmp(ptCandidate->sbcText, pcText, uTextLength) == 0))
+        {
+            // dynamic glyphs may have moved since, otherwise mark them used this frame
+            if(ptFont->tConfig.bDynamic)
+            {
+                if(ptCandidate->uEvictions != ptFont->ptParentAtlas->_uEvictions)
+                {
+                    ptLayout = ptCandidate;
+                    break;
+                }
+                for(uint32_t j = 0; j < plu_sb_size(ptCandidate->sbtGlyphs); j++)
+                    pl__find_dynamic_glyph(ptFont, ptCandidate->sbtGlyphs[j].uCodePoint);
+            }
+            ptCandidate->ulLastUsed = gptCtx->ulTextCacheTick;
+            gptCtx->uTextCacheHits++;
+            return ptCandidate;
+        }
+        if(ptCandidate->ulLastUsed < ptLayout->ulLastUsed)
+            ptLayout = ptCandidate;
+    }
+
+    // miss, so rebuild into the evicted way (glyph buffer is reused)
+    gptCtx->uTextCacheMisses++;
+    ptLayout->ptFont      = ptFont;
+    ptLayout->fSize       = fSize;
+    ptLayout->fWrap       = fWrap;
+    ptLayout->uHash       = uHash;
+    ptLayout->uTextLength = uTextLength;
+    ptLayout->ulLastUsed  = gptCtx->ulTextCacheTick;
+    plu_sb_resize(ptLayout->sbcText, uTextLength);
+    if(uTextLength > 0)
+        memcpy(ptLayout->sbcText, pcText, uTextLength);
+    ptLayout->tSize       = pl_calculate_text_size_ex(ptFont, fSize, pcText, pcTextEnd, fWrap);
+    ptLayout->tBBOffset   = pl_calculate_text_bb_ex(ptFont, fSize, (plVec2){0}, pcText, pcTextEnd, fWrap).tMin;
+    plu_sb_reset(ptLayout->sbtGlyphs);
+
+    // same walk as pl__add_text_run() but starting at the origin
+    const float fScale = fSize > 0.0f ? fSize / ptFont->tConfig.fFontSize : 1.0f;
+    const float fLineSpacing = fScale * ptFont->fLineSpacing;
+    plVec2 tPen = {0};
+    bool bFirstCharacter = true;
+    const char* pcCurrent = pcText;
+    while(pcCurrent < pcTextEnd)
+    {
+        uint32_t c = (uint32_t)*pcCurrent;
+        if(c < 0x80)
+            pcCurrent += 1;
+        else
+        {
+            pcCurrent += plu_text_char_from_utf8(&c, pcCurrent, NULL);
+            if(c == 0) // malformed UTF-8?
+                break;
+        }
+
+        if(c == '\n')
+        {
+            tPen.x = 0.0f;
+            tPen.y += fLineSpacing;
+        }
+        else if(c != '\r')
+        {
+            const plFontGlyph* ptGlyph = pl__find_glyph(ptFont, c);
+            if(ptGlyph == NULL) // not loaded into this font
+                continue;
+
+            // adjust for left side bearing if first char
+            if(bFirstCharacter)
+            {
+                if(ptGlyph->leftBearing > 0.0f) tPen.x += ptGlyph->leftBearing * fScale;
+                bFirstCharacter = false;
+            }
+
+            plUiTextGlyph tGlyph = {
+                .tMin       = {tPen.x + ptGlyph->x0 * fScale, tPen.y + ptGlyph->y0 * fScale},
+                .tMax       = {tPen.x + ptGlyph->x1 * fScale, tPen.y + ptGlyph->y1 * fScale},
+                .tUvMin     = {ptGlyph->u0, ptGlyph->v0},
+                .tUvMax     = {ptGlyph->u1, ptGlyph->v1},
+                .uCodePoint = c
+            };
+
+            if(fWrap > 0.0f && tGlyph.tMax.x > fWrap)
+            {
+                tGlyph.tMin.x = ptGlyph->x0 * fScale;
+                tGlyph.tMax.x = ptGlyph->x1 * fScale;
+                tGlyph.tMin.y += fLineSpacing;
+                tGlyph.tMax.y += fLineSpacing;
+                tPen.x = 0.0f;
+                tPen.y += fLineSpacing;
+            }
+
+            tPen.x += ptGlyph->xAdvance * fScale;
+            tGlyph.tPen = tPen;
+            if(c != ' ')
+                plu_sb_push(ptLayout->sbtGlyphs, tGlyph);
+        }
+    }
+
+    // after the walk, glyphs it rasterized may have evicted others
+    ptLayout->uEvictions = ptFont->ptParentAtlas->_uEvictions;
+    return ptLayout;
+}
+
+void
+pl__add_text_layout(plDrawLayer* ptLayer, const plUiTextLayout* ptLayout, plVec2 tP, plVec4 tColor, const plRect* ptClipRect)
+{
+    const uint32_t uGlyphCount = plu_sb_size(ptLayout->sbtGlyphs);
+    if(uGlyphCount == 0)
+        return;
+
+    const uint32_t uVtxStart = plu_sb_size(ptLayer->sbtVertexBuffer);
+    const uint32_t uIdxStart = plu_sb_size(ptLayer->sbuIndexBuffer);
+    plu_sb_reserve(ptLayer->sbtVertexBuffer, uVtxStart + uGlyphCount * 4);
+    plu_sb_reserve(ptLayer->sbuIndexBuffer, uIdxStart + uGlyphCount * 6);
+    plDrawVertex* ptVtxWrite = &ptLayer->sbtVertexBuffer[uVtxStart];
+    uint32_t*     puIdxWrite = &ptLayer->sbuIndexBuffer[uIdxStart];
+    uint32_t      uVtxCurrent = uVtxStart;
+
+    const uint32_t uColor = plu_pack_color(tColor);
+    bool bCommandPrepared = false;
+
+    for(uint32_t i = 0; i < uGlyphCount; i++)
+    {
+        const plUiTextGlyph* ptGlyph = &ptLayout->sbtGlyphs[i];
+        if(ptClipRect && !plu_rect_contains_point(ptClipRect, plu_add_vec2(tP, ptGlyph->tPen)))
+            continue;
+
+        if(!bCommandPrepared)
+        {
+            pl__prepare_draw_command(ptLayer, ptLayout->ptFont->ptParentAtlas->tTexture, ptLayout->ptFont->tConfig.bSdf);
+            bCommandPrepared = true;
+        }
+
+        const float x0 = tP.x + ptGlyph->tMin.x;
+        const float y0 = tP.y + ptGlyph->tMin.y;
+        const float x1 = tP.x + ptGlyph->tMax.x;
+        const float y1 = tP.y + ptGlyph->tMax.y;
+        ptVtxWrite[0] = (plDrawVertex){ .afPos = {x0, y0}, .afUv = {ptGlyph->tUvMin.x, ptGlyph->tUvMin.y}, .uColor = uColor };
+        ptVtxWrite[1] = (plDrawVertex){ .afPos = {x1, y0}, .afUv = {ptGlyph->tUvMax.x, ptGlyph->tUvMin.y}, .uColor = uColor };
+        ptVtxWrite[2] = (plDrawVertex){ .afPos = {x1, y1}, .afUv = {ptGlyph->tUvMax.x, ptGlyph->tUvMax.y}, .uColor = uColor };
+        ptVtxWrite[3] = (plDrawVertex){ .afPos = {x0, y1}, .afUv = {ptGlyph->tUvMin.x, ptGlyph->tUvMax.y}, .uColor = uColor };
+        ptVtxWrite += 4;
+
+        puIdxWrite[0] = uVtxCurrent + 1;
+        puIdxWrite[1] = uVtxCurrent;
+        puIdxWrite[2] = uVtxCurrent + 2;
+        puIdxWrite[3] = uVtxCurrent + 2;
+        puIdxWrite[4] = uVtxCurrent;
+        puIdxWrite[5] = uVtxCurrent + 3;
+        puIdxWrite += 6;
+        uVtxCurrent += 4;
+    }
+
+    const uint32_t uVtxWritten = uVtxCurrent - uVtxStart;
+    const uint32_t uIdxWritten = uVtxWritten / 4 * 6;
+    if(uVtxWritten > 0)
+    {
+        plu__sb_header(ptLayer->sbtVertexBuffer)->uSize += uVtxWritten;
+        plu__sb_header(ptLayer->sbuIndexBuffer)->uSize += uIdxWritten;
+        ptLayer->_ptLastCommand->uElementCount += uIdxWritten;
+        ptLayer->uVertexCount += uVtxWritten;
+    }
+}
+
+void
+pl__invalidate_text_cache(void)
+{
+    // glyph uvs & metrics belong to the atlas, so any rebuild makes every layout stale
+    for(uint32_t i = 0; i < PL_UI_TEXT_CACHE_SETS * PL_UI_TEXT_CACHE_WAYS; i++)
+    {
+        gptCtx->atTextCache[i].ptFont = NULL;
+        gptCtx->atTextCache[i].ulLastUsed = 0;
+    }
+}
+
+static inline uint32_t
+pl__arc_table_offset(uint32_t uSegments)
+{
+    // tables for even counts MIN, MIN + 2, ... are packed back to back
+    const uint32_t uHalf = uSegments / 2;
+    const uint32_t uMinHalf = PL_UI_CIRCLE_SEGMENTS_MIN / 2;
+    return uHalf * (uHalf - 1) - uMinHalf * (uMinHalf - 1);
+}
+
+static inline uint32_t
+pl__calculate_circle_segment_count(float fRadius, float fMaxError)
+{
+    // chord sagitta r * (1 - cos(pi / n)) <= max error
+    if(fRadius <= 0.0f || fMaxError <= 0.0f)
+        return PL_UI_CIRCLE_SEGMENTS_MIN;
+    const float fError = fMaxError < fRadius ? fMaxError : fRadius;
+    uint32_t uSegments = (uint32_t)ceilf(PLU_PI_2 * 2.0f / acosf(1.0f - fError / fRadius));
+    uSegments = (uSegments + 1) & ~1u; // round up to even
+    return plu_max(PL_UI_CIRCLE_SEGMENTS_MIN, plu_min(uSegments, PL_UI_CIRCLE_SEGMENTS_MAX));
+}
+
+void
+pl__update_circle_tables(void)
+{
+    // only the even counts automatic tessellation (and rounded rects, always a
+    // multiple of 4) can ask for, so drawing never writes to the context
+    if(gptCtx->sbtArcTable == NULL)
+    {
+        plu_sb_resize(gptCtx->sbtArcTable, pl__arc_table_offset(PL_UI_CIRCLE_SEGMENTS_MAX + 2));
+        for(uint32_t uSegments = PL_UI_CIRCLE_SEGMENTS_MIN; uSegments <= PL_UI_CIRCLE_SEGMENTS_MAX; uSegments += 2)
+        {
+            plVec2* atArc = &gptCtx->sbtArcTable[pl__arc_table_offset(uSegments)];
+            const float fIncrement = PLU_2PI / (float)uSegments;
+            for(uint32_t i = 0; i < uSegments; i++)
+                atArc[i] = (plVec2){cosf(fIncrement * (float)i), sinf(fIncrement * (float)i)};
+        }
+    }
+
+    // rebuild small radius lookup if the tolerance changed
+    if(gptCtx->fCircleSegmentMaxError != gptCtx->tIO.fCircleTessellationMaxError)
+    {
+        gptCtx->fCircleSegmentMaxError = gptCtx->tIO.fCircleTessellationMaxError;
+        for(uint32_t i = 0; i < 64; i++)
+            gptCtx->auCircleSegmentCounts[i] = (uint16_t)pl__calculate_circle_segment_count((float)i, gptCtx->fCircleSegmentMaxError);
+    }
+}
+
+static uint32_t
+pl__circle_segment_count(float fRadius)
+{
+    const uint32_t uRadius = (uint32_t)fRadius;
+    if(fRadius >= 0.0f && (float)uRadius == fRadius && uRadius < 64)
+        return gptCtx->auCircleSegmentCounts[uRadius];
+    return pl__calculate_circle_segment_count(fRadius, gptCtx->fCircleSegmentMaxError);
+}
+
+static const plVec2*
+pl__get_arc_table(uint32_t uSegments)
+{
+    // NULL for explicit odd or tiny counts (see pl__arc_point())
+    PL_UI_ASSERT(uSegments > 0 && uSegments <= PL_UI_CIRCLE_SEGMENTS_MAX);
+    if(uSegments < PL_UI_CIRCLE_SEGMENTS_MIN || (uSegments & 1u))
+        return NULL;
+    return &gptCtx->sbtArcTable[pl__arc_table_offset(uSegments)];
+}
+
+static inline plVec2
+pl__arc_point(const plVec2* atArc, uint32_t uSegments, uint32_t uIndex)
+{
+    if(atArc)
+        return atArc[uIndex];
+    const float fIncrement = PLU_2PI / (float)uSegments;
+    return (plVec2){cosf(fIncrement * (float)uIndex), sinf(fIncrement * (float)uIndex)};
+}
+
+static void
+pl__generate_sdf_glyphs(uint32_t uJobIndex, void* pData)
+{
+    const plSdfGlyphJob* ptJob = pData;
+    const plFontConfig* ptConfig = ptJob->ptConfig;
+    const float fSdfScale = stbtt_ScaleForPixelHeight(ptJob->ptFontInfo, ptConfig->fFontSize);
+
+    const uint32_t uStart = uJobIndex * PL_UI_SDF_GLYPHS_PER_JOB;
+    const uint32_t uEnd = plu_min(uStart + PL_UI_SDF_GLYPHS_PER_JOB, ptJob->uGlyphCount);
+    for(uint32_t i = uStart; i < uEnd; i++)
+    {
+        const int iCodePoint = ptJob->aiCodePoints[i];
+
+        int width = 0u;
+        int height = 0u;
+        int xOff = 0u;
+        int yOff = 0u;
+        unsigned char* bytes = stbtt_GetCodepointSDF(ptJob->ptFontInfo, fSdfScale, iCodePoint, ptConfig->iSdfPadding, ptConfig->ucOnEdgeValue, ptConfig->fSdfPixelDistScale, &width, &height, &xOff, &yOff);
+
+        int xAdvance = 0u;
+        stbtt_GetCodepointHMetrics(ptJob->ptFontInfo, iCodePoint, &xAdvance, NULL);
+
+        ptJob->atChars[i].xOff = (float)(xOff);
+        ptJob->atChars[i].yOff = (float)(yOff);
+        ptJob->atChars[i].xOff2 = (float)(xOff + width);
+        ptJob->atChars[i].yOff2 = (float)(yOff + height);
+        ptJob->atChars[i].xAdv = ptJob->fScale * (float)xAdvance;
+
+        ptJob->atRects[i] = (plFontCustomRect){
+            .uWidth = (uint32_t)width,
+            .uHeight = (uint32_t)height,
+            .pucBytes = bytes
+        };
+    }
+}
+
+static void
+pl__rasterize_font_range(uint32_t uJobIndex, void* pData)
+{
+    const plAtlasBuildJob* ptJob = pData;
+    const plFontRasterRange* ptRange = &ptJob->atRanges[uJobIndex];
+
+    // stb temporarily overwrites the oversampling on the context, so each job gets its own copy
+    stbtt_pack_context tPackContext = *ptJob->ptPackContext;
+    stbtt_PackFontRangesRenderIntoRects(&tPackContext, &ptRange->ptPrep->fontInfo, ptRange->ptRange, 1, ptRange->ptRects);
+}
+
+static void
+pl__blit_custom_rects(uint32_t uJobIndex, void* pData)
+{
+    const plAtlasBuildJob* ptJob = pData;
+    plFontAtlas* ptAtlas = ptJob->ptAtlas;
+
+    const uint32_t uStart = ptJob->uFirstCustomRect + uJobIndex * PL_UI_ATLAS_RECTS_PER_JOB;
+    const uint32_t uEnd = plu_min(uStart + PL_UI_ATLAS_RECTS_PER_JOB, plu_sb_size(ptAtlas->sbtCustomRects));
+    for(uint32_t r = uStart; r < uEnd; r++)
+    {
+        plFontCustomRect* ptCustomRect = &ptAtlas->sbtCustomRects[r];
+        for(uint32_t i = 0u; i < ptCustomRect->uHeight; i++)
+            memcpy(&ptAtlas->pucPixelsAsAlpha8[(ptCustomRect->uY + i) * ptAtlas->auAtlasSize[0] + ptCustomRect->uX], &ptCustomRect->pucBytes[i * ptCustomRect->uWidth], ptCustomRect->uWidth);
+        stbtt_FreeSDF(ptCustomRect->pucBytes, NULL);
+        ptCustomRect->pucBytes = NULL;
+    }
+}
+
+// white rgb + alpha, written byte by byte so the layout is RGBA in memory
+// regardless of endianness (still a straight loop the compiler vectorizes)
+static void
+pl__expand_alpha_to_rgba(unsigned char* pucDst, const unsigned char* pucSrc, size_t szCount)
+{
+    for(size_t i = 0; i < szCount; i++)
+    {
+        pucDst[i * 4 + 0] = 255;
+        pucDst[i * 4 + 1] = 255;
+        pucDst[i * 4 + 2] = 255;
+        pucDst[i * 4 + 3] = pucSrc[i];
+    }
+}
+
+static void
+pl__expand_atlas_alpha(uint32_t uJobIndex, void* pData)
+{
+    const plAtlasBuildJob* ptJob = pData;
+    const plFontAtlas* ptAtlas = ptJob->ptAtlas;
+
+    const uint32_t uRowStart = uJobIndex * PL_UI_ATLAS_ROWS_PER_JOB;
+    const uint32_t uRowEnd = plu_min(uRowStart + PL_UI_ATLAS_ROWS_PER_JOB, ptAtlas->auAtlasSize[1]);
+    const size_t szStart = (size_t)uRowStart * ptAtlas->auAtlasSize[0];
+    const size_t szEnd = (size_t)uRowEnd * ptAtlas->auAtlasSize[0];
+    pl__expand_alpha_to_rgba(&ptAtlas->pucPixelsAsRGBA32[szStart * 4], &ptAtlas->pucPixelsAsAlpha8[szStart], szEnd - szStart);
+}
+
+static void
+pl__compile_drawlist_layer(uint32_t uLayerIndex, void* pData)
+{
+    plDrawList* ptDrawlist = pData;
+    const plDrawLayer* ptLayer = ptDrawlist->sbtSubmittedLayers[uLayerIndex];
+    const uint32_t uVertexBase = ptDrawlist->_sbuLayerVertexBases[uLayerIndex];
+
+    if(plu_sb_size(ptLayer->sbtVertexBuffer) > 0)
+        memcpy(&ptDrawlist->sbtVertexBuffer[uVertexBase], ptLayer->sbtVertexBuffer, sizeof(plDrawVertex) * plu_sb_size(ptLayer->sbtVertexBuffer));
+
+    uint32_t* puIndexDst = &ptDrawlist->sbuIndexBuffer[ptDrawlist->_sbuLayerIndexBases[uLayerIndex]];
+    for(uint32_t i = 0u; i < plu_sb_size(ptLayer->sbtCommandBuffer); i++)
+    {
+        const plDrawCommand* ptCommand = &ptLayer->sbtCommandBuffer[i];
+        if(!pl__draw_command_visible(ptCommand))
+            continue;
+
+        const uint32_t* puIndexSrc = &ptLayer->sbuIndexBuffer[ptCommand->uIndexOffset];
+        for(uint32_t j = 0u; j < ptCommand->uElementCount; j++)
+            puIndexDst[j] = puIndexSrc[j] + uVertexBase;
+        puIndexDst += ptCommand->uElementCount;
+    }
+}
+
+static void
+pl__build_codepoint_table(plFont* ptFont)
+{
+    plu_sb_reset(ptFont->sbuCodePointPages);
+    plu_sb_reset(ptFont->sbuCodePoints);
+
+    // size top level to the highest codepoint
+    uint32_t uPageCount = 0u;
+    for(uint32_t i = 0u; i < plu_sb_size(ptFont->tConfig.sbtRanges); i++)
+    {
+        const plFontRange* ptRange = &ptFont->tConfig.sbtRanges[i];
+        if(ptRange->uCharCount == 0)
+            continue;
+        const uint32_t uLastPage = ((uint32_t)ptRange->iFirstCodePoint + ptRange->uCharCount - 1) >> PL__CODEPOINT_PAGE_SHIFT;
+        if(uLastPage + 1 > uPageCount)
+            uPageCount = uLastPage + 1;
+    }
+    plu_sb_resize(ptFont->sbuCodePointPages, uPageCount);
+    for(uint32_t i = 0u; i < uPageCount; i++)
+        ptFont->sbuCodePointPages[i] = PL__GLYPH_NOT_FOUND;
+
+    // allocate pages touched by ranges (entries start as the missing glyph sentinel)
+    for(uint32_t i = 0u; i < plu_sb_size(ptFont->tConfig.sbtRanges); i++)
+    {
+        const plFontRange* ptRange = &ptFont->tConfig.sbtRanges[i];
+        if(ptRange->uCharCount == 0)
+            continue;
+        const uint32_t uFirstPage = (uint32_t)ptRange->iFirstCodePoint >> PL__CODEPOINT_PAGE_SHIFT;
+        const uint32_t uLastPage = ((uint32_t)ptRange->iFirstCodePoint + ptRange->uCharCount - 1) >> PL__CODEPOINT_PAGE_SHIFT;
+        for(uint32_t uPage = uFirstPage; uPage <= uLastPage; uPage++)
+        {
+            if(ptFont->sbuCodePointPages[uPage] != PL__GLYPH_NOT_FOUND)
+                continue;
+            const uint32_t uPageSlot = plu_sb_size(ptFont->sbuCodePoints) / PL__CODEPOINT_PAGE_SIZE;
+            plu_sb_resize(ptFont->sbuCodePoints, (uPageSlot + 1) * PL__CODEPOINT_PAGE_SIZE);
+            for(uint32_t j = 0u; j < PL__CODEPOINT_PAGE_SIZE; j++)
+                ptFont->sbuCodePoints[uPageSlot * PL__CODEPOINT_PAGE_SIZE + j] = PL__GLYPH_NOT_FOUND;
+            ptFont->sbuCodePointPages[uPage] = uPageSlot;
+        }
+    }
+}
+
+static void
+pl__map_codepoints(plFont* ptFont)
+{
+    // glyphs are stored in range order
+    uint32_t uGlyphIndex = 0u;
+    for(uint32_t i = 0u; i < plu_sb_size(ptFont->tConfig.sbtRanges); i++)
+    {
+        const plFontRange* ptRange = &ptFont->tConfig.sbtRanges[i];
+        for(uint32_t j = 0u; j < ptRange->uCharCount; j++)
+        {
+            const uint32_t uCodePoint = (uint32_t)ptRange->iFirstCodePoint + j;
+            const uint32_t uPageSlot = ptFont->sbuCodePointPages[uCodePoint >> PL__CODEPOINT_PAGE_SHIFT];
+            ptFont->sbuCodePoints[uPageSlot * PL__CODEPOINT_PAGE_SIZE + (uCodePoint & (PL__CODEPOINT_PAGE_SIZE - 1))] = uGlyphIndex++;
+        }
+    }
+    pl__build_ascii_table(ptFont);
+}
+
+static void
+pl__build_ascii_table(plFont* ptFont)
+{
+    if(ptFont->_ptAsciiTable == NULL)
+        ptFont->_ptAsciiTable = pl_memory_alloc(sizeof(plFontAsciiTable));
+    memset(ptFont->_ptAsciiTable, 0, sizeof(plFontAsciiTable));
+
+    plFontAsciiTable* ptTable = ptFont->_ptAsciiTable;
+    for(uint32_t c = 0u; c < 128u; c++)
+    {
+        const plFontGlyph* ptGlyph = pl__find_glyph(ptFont, c);
+        if(ptGlyph == NULL)
+        {
+            ptTable->auGlyph[c] = PL__GLYPH_NOT_FOUND;
+            continue;
+        }
+        ptTable->auGlyph[c]       = (uint32_t)(ptGlyph - ptFont->sbtGlyphs);
+        ptTable->afXAdvance[c]    = ptGlyph->xAdvance;
+        ptTable->afX0[c]          = ptGlyph->x0;
+        ptTable->afY0[c]          = ptGlyph->y0;
+        ptTable->afX1[c]          = ptGlyph->x1;
+        ptTable->afY1[c]          = ptGlyph->y1;
+        ptTable->afLeftBearing[c] = ptGlyph->leftBearing;
+    }
+}
+
+static uint32_t
+pl__hash_font(const plFontConfig* ptConfig, const void* pTtf, size_t szTtfSize, const char* pcCompressedTtf)
+{
+    uint32_t uHash = 0u;
+
+    // embedded data is hashed whole, for ttf files the table directory is enough
+    // since it carries a checksum for every table (szTtfSize == 0 means the size
+    // is unknown and the data is trusted, as stb_truetype does)
+    if(pcCompressedTtf)
+        uHash = plu_str_hash_data(pcCompressedTtf, strlen(pcCompressedTtf), uHash);
+    else if(pTtf)
+    {
+        const unsigned char* pucTtf = pTtf;
+        size_t szHashSize = szTtfSize;
+        if(szTtfSize == 0 || szTtfSize >= 12)
         {
-            plFontPrepData* prep = &atlas->_sbtPrepData[i];
-            stbtt_PackSetOversampling(&spc, font->tConfig.uHOverSampling, font->tConfig.uVOverSampling);
-            stbrp_pack_rects((stbrp_context*)spc.pack_info, prep->rects, prep->uTotalCharCount);
-            for(uint32_t j = 0u; j < prep->uTotalCharCount; j++)
-            {
-                if(prep->rects[j].was_packed)
-                    atlas->auAtlasSize[1] = (uint32_t)pl__get_max((float)atlas->auAtlasSize[1], (float)(prep->rects[j].y + prep->rects[j].h));
-            }
+            const uint32_t uTableCount = ((uint32_t)pucTtf[4] << 8) | (uint32_t)pucTtf[5];
+            const size_t szDirectorySize = 12 + 16 * (size_t)uTableCount;
+            if(szTtfSize == 0 || szDirectorySize <= szTtfSize)
+                szHashSize = szDirectorySize;
         }
+
+        // truncated or bogus directory, fall back to everything there is
+        uHash = plu_str_hash_data(pucTtf, szHashSize, uHash);
     }
 
-    // pack SDF fonts
-    stbtt_PackSetOversampling(&spc, 1, 1);
-    stbrp_pack_rects((stbrp_context*)spc.pack_info, rects, plu_sb_size(atlas->sbtCustomRects));
+    // only fields that change the output (fSdfPixelDistScale is derived)
+    uHash = plu_str_hash_data(&ptConfig->fFontSize, sizeof(float), uHash);
+    uHash = plu_str_hash_data(&ptConfig->uVOverSampling, sizeof(uint32_t), uHash);
+    uHash = plu_str_hash_data(&ptConfig->uHOverSampling, sizeof(uint32_t), uHash);
+    uHash = plu_str_hash_data(&ptConfig->bSdf, sizeof(bool), uHash);
+    uHash = plu_str_hash_data(&ptConfig->iSdfPadding, sizeof(int), uHash);
+    uHash = plu_str_hash_data(&ptConfig->ucOnEdgeValue, sizeof(unsigned char), uHash);
+    for(uint32_t i = 0u; i < plu_sb_size(ptConfig->sbtRanges); i++)
+    {
+        uHash = plu_str_hash_data(&ptConfig->sbtRanges[i].iFirstCodePoint, sizeof(int), uHash);
+        uHash = plu_str_hash_data(&ptConfig->sbtRanges[i].uCharCount, sizeof(uint32_t), uHash);
+    }
+    return uHash;
+}
 
-    for(uint32_t i = 0u; i < plu_sb_size(atlas->sbtCustomRects); i++)
+static uint32_t
+pl__font_atlas_cache_key(const plFontAtlas* ptAtlas)
+{
+    uint32_t uKey = plu_str_hash_data(&ptAtlas->iGlyphPadding, sizeof(int), PL_UI_ATLAS_CACHE_VERSION);
+    for(uint32_t i = 0u; i < plu_sb_size(ptAtlas->_sbtPrepData); i++)
+        uKey = plu_str_hash_data(&ptAtlas->_sbtPrepData[i].uKey, sizeof(uint32_t), uKey);
+    return uKey;
+}
+
+static bool
+pl__load_font_atlas_cache(plFontAtlas* ptAtlas)
+{
+    FILE* ptFile = fopen(ptAtlas->pcCacheFile, "rb");
+    if(ptFile == NULL)
+        return false;
+
+    fseek(ptFile, 0, SEEK_END);
+    const size_t szFileSize = (size_t)ftell(ptFile);
+    fseek(ptFile, 0, SEEK_SET);
+
+    // whole file in one read, then parse in place
+    unsigned char* pucData = pl_memory_alloc(szFileSize);
+    const bool bRead = fread(pucData, 1, szFileSize, ptFile) == szFileSize;
+    fclose(ptFile);
+
+    const bool bLoaded = bRead && pl__load_font_atlas_data(ptAtlas, pucData, szFileSize, false);
+    pl_memory_free(pucData);
+    return bLoaded;
+}
+
+static bool
+pl__load_font_atlas_data(plFontAtlas* ptAtlas, const unsigned char* pucData, size_t szSize, bool bBorrowPixels)
+{
+    // structs are copied out since baked arrays carry no alignment guarantees
+    plFontAtlasCacheHeader tHeader = {0};
+    if(szSize < sizeof(plFontAtlasCacheHeader))
+        return false;
+    memcpy(&tHeader, pucData, sizeof(plFontAtlasCacheHeader));
+
+    if(memcmp(tHeader.acMagic, "PLFA", 4) != 0 || tHeader.uVersion != PL_UI_ATLAS_CACHE_VERSION ||
+        tHeader.uKey != pl__font_atlas_cache_key(ptAtlas) || tHeader.uFontCount != plu_sb_size(ptAtlas->sbtFonts) ||
+        tHeader.uWhiteRectIndex >= tHeader.uCustomRectCount)
+        return false;
+
+    // validate sizes before touching the atlas
+    const size_t szPixelCount = (size_t)tHeader.auAtlasSize[0] * tHeader.auAtlasSize[1];
+    size_t szExpected = sizeof(plFontAtlasCacheHeader) + sizeof(uint32_t) * 4 * tHeader.uCustomRectCount + szPixelCount;
+    const unsigned char* pucCursor = pucData + sizeof(plFontAtlasCacheHeader);
+    for(uint32_t i = 0u; i < tHeader.uFontCount; i++)
     {
-        if(rects[i].was_packed)
-            atlas->auAtlasSize[1] = (uint32_t)pl__get_max((float)atlas->auAtlasSize[1], (float)(rects[i].y + rects[i].h));
+        plFontCacheEntry tEntry = {0};
+        if(szExpected + sizeof(plFontCacheEntry) > szSize)
+            return false;
+        memcpy(&tEntry, pucCursor, sizeof(plFontCacheEntry));
+        if(tEntry.uCharCount != plu_sb_size(ptAtlas->sbtFonts[i]->sbtCharData))
+            return false;
+        const size_t szEntrySize = sizeof(plFontCacheEntry) + sizeof(plFontGlyph) * tEntry.uGlyphCount + sizeof(plFontChar) * tEntry.uCharCount;
+        szExpected += szEntrySize;
+        pucCursor += szEntrySize;
     }
+    if(szExpected != szSize)
+        return false;
 
-    // grow cpu side buffers if needed
-    if(atlas->szPixelDataSize < atlas->auAtlasSize[0] * atlas->auAtlasSize[1])
+    // fonts
+    pucCursor = pucData + sizeof(plFontAtlasCacheHeader);
+    for(uint32_t i = 0u; i < tHeader.uFontCount; i++)
     {
-        if(atlas->pucPixelsAsAlpha8) pl_memory_free(atlas->pucPixelsAsAlpha8);
-        if(atlas->pucPixelsAsRGBA32) pl_memory_free(atlas->pucPixelsAsRGBA32);
+        plFont* ptFont = ptAtlas->sbtFonts[i];
+        plFontCacheEntry tEntry = {0};
+        memcpy(&tEntry, pucCursor, sizeof(plFontCacheEntry));
+        pucCursor += sizeof(plFontCacheEntry);
 
-        atlas->pucPixelsAsAlpha8 = pl_memory_alloc(atlas->auAtlasSize[0] * atlas->auAtlasSize[1]);   
-        atlas->pucPixelsAsRGBA32 = pl_memory_alloc(atlas->auAtlasSize[0] * atlas->auAtlasSize[1] * 4);
+        ptFont->fLineSpacing = tEntry.fLineSpacing;
+        ptFont->fAscent = tEntry.fAscent;
+        ptFont->fDescent = tEntry.fDescent;
+        ptFont->tConfig.fSdfPixelDistScale = tEntry.fSdfPixelDistScale;
 
-        memset(atlas->pucPixelsAsAlpha8, 0, atlas->auAtlasSize[0] * atlas->auAtlasSize[1]);
-        memset(atlas->pucPixelsAsRGBA32, 0, atlas->auAtlasSize[0] * atlas->auAtlasSize[1] * 4);
+        plu_sb_resize(ptFont->sbtGlyphs, tEntry.uGlyphCount);
+        memcpy(ptFont->sbtGlyphs, pucCursor, sizeof(plFontGlyph) * tEntry.uGlyphCount);
+        pucCursor += sizeof(plFontGlyph) * tEntry.uGlyphCount;
+
+        memcpy(ptFont->sbtCharData, pucCursor, sizeof(plFontChar) * tEntry.uCharCount);
+        pucCursor += sizeof(plFontChar) * tEntry.uCharCount;
+
+        pl__build_codepoint_table(ptFont);
+        pl__map_codepoints(ptFont);
     }
-    spc.pixels = atlas->pucPixelsAsAlpha8;
-    atlas->szPixelDataSize = atlas->auAtlasSize[0] * atlas->auAtlasSize[1];
 
-    // rasterize bitmap fonts
-    for(uint32_t i = 0u; i < plu_sb_size(atlas->_sbtPrepData); i++)
+    // custom rects (pixels already live in the atlas)
+    plu_sb_resize(ptAtlas->sbtCustomRects, tHeader.uCustomRectCount);
+    for(uint32_t i = 0u; i < tHeader.uCustomRectCount; i++)
     {
-        plFont* font = &atlas->sbtFonts[i];
-        plFontPrepData* prep = &atlas->_sbtPrepData[i];
-        if(!atlas->sbtFonts[i].tConfig.bSdf)
-            stbtt_PackFontRangesRenderIntoRects(&spc, &prep->fontInfo, prep->ranges, plu_sb_size(font->tConfig.sbtRanges), prep->rects);
+        uint32_t auRect[4] = {0};
+        memcpy(auRect, pucCursor, sizeof(auRect));
+        ptAtlas->sbtCustomRects[i] = (plFontCustomRect){
+            .uX       = auRect[0],
+            .uY       = auRect[1],
+            .uWidth   = auRect[2],
+            .uHeight  = auRect[3]
+        };
+        pucCursor += sizeof(auRect);
+    }
+    ptAtlas->ptWhiteRect = &ptAtlas->sbtCustomRects[tHeader.uWhiteRectIndex];
+
+    // pixels
+    ptAtlas->auAtlasSize[0] = tHeader.auAtlasSize[0];
+    ptAtlas->auAtlasSize[1] = tHeader.auAtlasSize[1];
+    ptAtlas->afWhiteUv[0] = tHeader.afWhiteUv[0];
+    ptAtlas->afWhiteUv[1] = tHeader.afWhiteUv[1];
+    if(ptAtlas->pucPixelsAsAlpha8 && !ptAtlas->_bBorrowedPixels) pl_memory_free(ptAtlas->pucPixelsAsAlpha8);
+    if(ptAtlas->pucPixelsAsRGBA32) pl_memory_free(ptAtlas->pucPixelsAsRGBA32);
+    ptAtlas->pucPixelsAsRGBA32 = ptAtlas->bAlpha8Only ? NULL : pl_memory_alloc(szPixelCount * 4);
+    if(bBorrowPixels)
+        ptAtlas->pucPixelsAsAlpha8 = (unsigned char*)pucCursor;
+    else
+    {
+        ptAtlas->pucPixelsAsAlpha8 = pl_memory_alloc(szPixelCount);
+        memcpy(ptAtlas->pucPixelsAsAlpha8, pucCursor, szPixelCount);
     }
+    ptAtlas->_bBorrowedPixels = bBorrowPixels;
+    ptAtlas->szPixelDataSize = szPixelCount;
+    if(ptAtlas->bAlpha8Only)
+        return true;
 
-    // update SDF/custom data
-    for(uint32_t i = 0u; i < plu_sb_size(atlas->sbtCustomRects); i++)
+    plAtlasBuildJob tBuildJob = {
+        .ptAtlas = ptAtlas
+    };
+    pl__dispatch_jobs(pl__expand_atlas_alpha, &tBuildJob, (ptAtlas->auAtlasSize[1] + PL_UI_ATLAS_ROWS_PER_JOB - 1) / PL_UI_ATLAS_ROWS_PER_JOB, NULL);
+    return true;
+}
+
+static unsigned char*
+pl__serialize_font_atlas(const plFontAtlas* ptAtlas, size_t* pszSize)
+{
+    const size_t szPixelCount = (size_t)ptAtlas->auAtlasSize[0] * ptAtlas->auAtlasSize[1];
+    size_t szSize = sizeof(plFontAtlasCacheHeader) + sizeof(uint32_t) * 4 * plu_sb_size(ptAtlas->sbtCustomRects) + szPixelCount;
+    for(uint32_t i = 0u; i < plu_sb_size(ptAtlas->sbtFonts); i++)
+        szSize += sizeof(plFontCacheEntry) + sizeof(plFontGlyph) * plu_sb_size(ptAtlas->sbtFonts[i]->sbtGlyphs) + sizeof(plFontChar) * plu_sb_size(ptAtlas->sbtFonts[i]->sbtCharData);
+
+    unsigned char* pucData = pl_memory_alloc(szSize);
+    unsigned char* pucCursor = pucData;
+
+    const plFontAtlasCacheHeader tHeader = {
+        .acMagic          = {'P', 'L', 'F', 'A'},
+        .uVersion         = PL_UI_ATLAS_CACHE_VERSION,
+        .uKey             = pl__font_atlas_cache_key(ptAtlas),
+        .uFontCount       = plu_sb_size(ptAtlas->sbtFonts),
+        .uCustomRectCount = plu_sb_size(ptAtlas->sbtCustomRects),
+        .uWhiteRectIndex  = (uint32_t)(ptAtlas->ptWhiteRect - ptAtlas->sbtCustomRects),
+        .auAtlasSize      = {ptAtlas->auAtlasSize[0], ptAtlas->auAtlasSize[1]},
+        .afWhiteUv        = {ptAtlas->afWhiteUv[0], ptAtlas->afWhiteUv[1]}
+    };
+    memcpy(pucCursor, &tHeader, sizeof(tHeader));
+    pucCursor += sizeof(tHeader);
+
+    for(uint32_t i = 0u; i < plu_sb_size(ptAtlas->sbtFonts); i++)
     {
-        atlas->sbtCustomRects[i].uX = (uint32_t)rects[i].x;
-        atlas->sbtCustomRects[i].uY = (uint32_t)rects[i].y;
+        const plFont* ptFont = ptAtlas->sbtFonts[i];
+        const plFontCacheEntry tEntry = {
+            .fLineSpacing       = ptFont->fLineSpacing,
+            .fAscent            = ptFont->fAscent,
+            .fDescent           = ptFont->fDescent,
+            .fSdfPixelDistScale = ptFont->tConfig.fSdfPixelDistScale,
+            .uGlyphCount        = plu_sb_size(ptFont->sbtGlyphs),
+            .uCharCount         = plu_sb_size(ptFont->sbtCharData)
+        };
+        memcpy(pucCursor, &tEntry, sizeof(tEntry));
+        pucCursor += sizeof(tEntry);
+        if(tEntry.uGlyphCount > 0)
+            memcpy(pucCursor, ptFont->sbtGlyphs, sizeof(plFontGlyph) * tEntry.uGlyphCount);
+        pucCursor += sizeof(plFontGlyph) * tEntry.uGlyphCount;
+        if(tEntry.uCharCount > 0)
+            memcpy(pucCursor, ptFont->sbtCharData, sizeof(plFontChar) * tEntry.uCharCount);
+        pucCursor += sizeof(plFontChar) * tEntry.uCharCount;
     }
 
-    uint32_t charDataOffset = 0u;
-    for(uint32_t fontIndex = 0u; fontIndex < plu_sb_size(atlas->sbtFonts); fontIndex++)
+    for(uint32_t i = 0u; i < plu_sb_size(ptAtlas->sbtCustomRects); i++)
     {
-        plFont* font = &atlas->sbtFonts[fontIndex];
-        if(font->tConfig.bSdf)
-        {
-            for(uint32_t i = 0u; i < plu_sb_size(font->sbtCharData); i++)
-            {
-                font->sbtCharData[i].x0 = (uint16_t)rects[charDataOffset + i].x;
-                font->sbtCharData[i].y0 = (uint16_t)rects[charDataOffset + i].y;
-                font->sbtCharData[i].x1 = (uint16_t)(rects[charDataOffset + i].x + atlas->sbtCustomRects[charDataOffset + i].uWidth);
-                font->sbtCharData[i].y1 = (uint16_t)(rects[charDataOffset + i].y + atlas->sbtCustomRects[charDataOffset + i].uHeight);
-                
-            }
-            charDataOffset += plu_sb_size(font->sbtCharData);  
-        }
+        const plFontCustomRect* ptRect = &ptAtlas->sbtCustomRects[i];
+        const uint32_t auRect[4] = {ptRect->uX, ptRect->uY, ptRect->uWidth, ptRect->uHeight};
+        memcpy(pucCursor, auRect, sizeof(auRect));
+        pucCursor += sizeof(auRect);
     }
 
-    // end packing
-    stbtt_PackEnd(&spc);
+    memcpy(pucCursor, ptAtlas->pucPixelsAsAlpha8, szPixelCount);
+    *pszSize = szSize;
+    return pucData;
+}
 
-    // rasterize SDF/custom rects
-    for(uint32_t r = 0u; r < plu_sb_size(atlas->sbtCustomRects); r++)
+static void
+pl__save_font_atlas_cache(const plFontAtlas* ptAtlas)
+{
+    FILE* ptFile = fopen(ptAtlas->pcCacheFile, "wb");
+    if(ptFile == NULL)
+        return;
+
+    size_t szSize = 0;
+    unsigned char* pucData = pl__serialize_font_atlas(ptAtlas, &szSize);
+    fwrite(pucData, 1, szSize, ptFile);
+    fclose(ptFile);
+    pl_memory_free(pucData);
+}
+
+static plFontGlyph
+pl__make_glyph(const plFontAtlas* ptAtlas, const plFont* ptFont, const plFontPrepData* ptPrep, const plFontChar* ptChar, int iCodePoint)
+{
+    float fPixelHeight = 0.0f;
+    if(ptFont->tConfig.bSdf) fPixelHeight = 0.5f * 1.0f / (float)ptAtlas->auAtlasSize[1]; // is this correct?
+
+    stbtt_aligned_quad q;
+    float fUnusedX = 0.0f, fUnusedY = 0.0f;
+    stbtt_GetPackedQuad((const stbtt_packedchar*)ptChar, ptAtlas->auAtlasSize[0], ptAtlas->auAtlasSize[1], 0, &fUnusedX, &fUnusedY, &q, 0);
+
+    int iUnusedAdvance, iLeftSideBearing;
+    stbtt_GetCodepointHMetrics(&ptPrep->fontInfo, iCodePoint, &iUnusedAdvance, &iLeftSideBearing);
+
+    return (plFontGlyph){
+        .x0 = q.x0,
+        .y0 = q.y0 + ptFont->fAscent,
+        .x1 = q.x1,
+        .y1 = q.y1 + ptFont->fAscent,
+        .u0 = q.s0,
+        .v0 = q.t0 + fPixelHeight,
+        .u1 = q.s1,
+        .v1 = q.t1 - fPixelHeight,
+        .xAdvance = ptChar->xAdv,
+        .leftBearing = (float)iLeftSideBearing * ptPrep->scale
+    };
+}
+
+static void
+pl__add_font_glyphs(plFontAtlas* ptAtlas, uint32_t uFontIndex)
+{
+    plFont* ptFont = ptAtlas->sbtFonts[uFontIndex];
+
+    pl__build_codepoint_table(ptFont);
+
+    // dynamic fonts start out empty & keep their ttf for later rasterization
+    if(ptFont->tConfig.bDynamic)
+    {
+        plu_sb_reset(ptFont->sbtGlyphs);
+        plu_sb_reset(ptFont->_sbuGlyphShelves);
+        plu_sb_reset(ptFont->_sbuGlyphCodePoints);
+        plu_sb_reset(ptFont->_sbuFreeGlyphs);
+        return;
+    }
+
+    uint32_t uCharIndex = 0u;
+    for(uint32_t i = 0u; i < plu_sb_size(ptFont->tConfig.sbtRanges); i++)
     {
-        plFontCustomRect* customRect = &atlas->sbtCustomRects[r];
-        for(uint32_t i = 0u; i < customRect->uHeight; i++)
+        const plFontRange* ptRange = &ptFont->tConfig.sbtRanges[i];
+        for(uint32_t j = 0u; j < ptRange->uCharCount; j++)
         {
-            for(uint32_t j = 0u; j < customRect->uWidth; j++)
-                atlas->pucPixelsAsAlpha8[(customRect->uY + i) * atlas->auAtlasSize[0] + (customRect->uX + j)] =  customRect->pucBytes[i * customRect->uWidth + j];
+            const plFontGlyph tGlyph = pl__make_glyph(ptAtlas, ptFont, &ptAtlas->_sbtPrepData[uFontIndex], &ptFont->sbtCharData[uCharIndex], ptRange->iFirstCodePoint + j);
+            plu_sb_push(ptFont->sbtGlyphs, tGlyph);
+            uCharIndex++;
         }
-        stbtt_FreeSDF(customRect->pucBytes, NULL);
-        customRect->pucBytes = NULL;
     }
+    pl__map_codepoints(ptFont);
 
-    // update white point uvs
-    atlas->afWhiteUv[0] = (float)(atlas->ptWhiteRect->uX + atlas->ptWhiteRect->uWidth / 2) / (float)atlas->auAtlasSize[0];
-    atlas->afWhiteUv[1] = (float)(atlas->ptWhiteRect->uY + atlas->ptWhiteRect->uHeight / 2) / (float)atlas->auAtlasSize[1];
+    pl__release_font_data(&ptAtlas->_sbtPrepData[uFontIndex]);
+}
 
-    // add glyphs
-    for(uint32_t fontIndex = 0u; fontIndex < plu_sb_size(atlas->sbtFonts); fontIndex++)
+static bool
+pl__grow_font_atlas(plFontAtlas* ptAtlas, uint32_t uHeight)
+{
+    // borrowed (baked) pixels are read only, so those are copied even without growth
+    const uint32_t uOldHeight = ptAtlas->auAtlasSize[1];
+    if(uHeight <= uOldHeight && !ptAtlas->_bBorrowedPixels)
+        return false;
+    uHeight = plu_max(uHeight, uOldHeight);
+
+    // width never changes, so existing rows copy straight across
+    const size_t szOldCount = (size_t)ptAtlas->auAtlasSize[0] * uOldHeight;
+    const size_t szNewCount = (size_t)ptAtlas->auAtlasSize[0] * uHeight;
+
+    unsigned char* pucAlpha8 = pl_memory_alloc(szNewCount);
+    memcpy(pucAlpha8, ptAtlas->pucPixelsAsAlpha8, szOldCount);
+    memset(&pucAlpha8[szOldCount], 0, szNewCount - szOldCount);
+    if(!ptAtlas->_bBorrowedPixels)
+        pl_memory_free(ptAtlas->pucPixelsAsAlpha8);
+    ptAtlas->pucPixelsAsAlpha8 = pucAlpha8;
+    ptAtlas->_bBorrowedPixels = false;
+
+    if(ptAtlas->pucPixelsAsRGBA32)
     {
-        plFont* font = &atlas->sbtFonts[fontIndex];
+        unsigned char* pucRGBA32 = pl_memory_alloc(szNewCount * 4);
+        memcpy(pucRGBA32, ptAtlas->pucPixelsAsRGBA32, szOldCount * 4);
+        pl__expand_alpha_to_rgba(&pucRGBA32[szOldCount * 4], &pucAlpha8[szOldCount], szNewCount - szOldCount);
+        pl_memory_free(ptAtlas->pucPixelsAsRGBA32);
+        ptAtlas->pucPixelsAsRGBA32 = pucRGBA32;
+    }
+    ptAtlas->szPixelDataSize = szNewCount;
+    ptAtlas->auAtlasSize[1] = uHeight;
 
-        uint32_t charIndex = 0u;
-        float pixelHeight = 0.0f;
-        if(font->tConfig.bSdf) pixelHeight = 0.5f * 1.0f / (float)atlas->auAtlasSize[1]; // is this correct?
-        
-        for(uint32_t i = 0u; i < plu_sb_size(font->tConfig.sbtRanges); i++)
+    // uvs are normalized, so everything already placed moves up
+    if(uHeight != uOldHeight)
+    {
+        const float fScale = (float)uOldHeight / (float)uHeight;
+        for(uint32_t i = 0u; i < ptAtlas->_uBuiltFontCount; i++)
         {
-            plFontRange* range = &font->tConfig.sbtRanges[i];
-            for(uint32_t j = 0u; j < range->uCharCount; j++)
+            plFont* ptFont = ptAtlas->sbtFonts[i];
+            for(uint32_t j = 0u; j < plu_sb_size(ptFont->sbtGlyphs); j++)
             {
-                const int codePoint = range->iFirstCodePoint + j;
-                stbtt_aligned_quad q;
-                float unused_x = 0.0f, unused_y = 0.0f;
-                stbtt_GetPackedQuad((stbtt_packedchar*)font->sbtCharData, atlas->auAtlasSize[0], atlas->auAtlasSize[1], charIndex, &unused_x, &unused_y, &q, 0);
-
-                int unusedAdvanced, leftSideBearing;
-                stbtt_GetCodepointHMetrics(&atlas->_sbtPrepData[fontIndex].fontInfo, codePoint, &unusedAdvanced, &leftSideBearing);
-
-                plFontGlyph glyph = {
-                    .x0 = q.x0,
-                    .y0 = q.y0 + font->fAscent,
-                    .x1 = q.x1,
-                    .y1 = q.y1 + font->fAscent,
-                    .u0 = q.s0,
-                    .v0 = q.t0 + pixelHeight,
-                    .u1 = q.s1,
-                    .v1 = q.t1 - pixelHeight,
-                    .xAdvance = font->sbtCharData[charIndex].xAdv,
-                    .leftBearing = (float)leftSideBearing * atlas->_sbtPrepData[fontIndex].scale
-                };
-                plu_sb_push(font->sbtGlyphs, glyph);
-                font->sbuCodePoints[codePoint] = plu_sb_size(font->sbtGlyphs) - 1;
-                charIndex++;
+                ptFont->sbtGlyphs[j].v0 *= fScale;
+                ptFont->sbtGlyphs[j].v1 *= fScale;
             }
         }
-
-        pl_memory_free(atlas->_sbtPrepData[fontIndex].fontInfo.data);
+        ptAtlas->afWhiteUv[1] *= fScale;
+        if(gptCtx)
+            pl__invalidate_text_cache();
     }
+    return true;
+}
 
-    // convert to 4 color channels
-    for(uint32_t i = 0u; i < atlas->auAtlasSize[0] * atlas->auAtlasSize[1]; i++)
-    {
-        atlas->pucPixelsAsRGBA32[i * 4] = 255;
-        atlas->pucPixelsAsRGBA32[i * 4 + 1] = 255;
-        atlas->pucPixelsAsRGBA32[i * 4 + 2] = 255;
-        atlas->pucPixelsAsRGBA32[i * 4 + 3] = atlas->pucPixelsAsAlpha8[i];
-    }
+static void
+pl__free_font_packer(plFontAtlas* ptAtlas)
+{
+    if(ptAtlas->_ptPacker == NULL)
+        return;
+    stbtt_PackEnd(&ptAtlas->_ptPacker->tContext);
+    pl_memory_free(ptAtlas->_ptPacker);
+    ptAtlas->_ptPacker = NULL;
+}
 
-    pl_memory_free(rects);
+const plFontGlyph*
+pl__find_dynamic_glyph(plFont* ptFont, uint32_t uCodePoint)
+{
+    uint32_t uGlyphIndex = PL__GLYPH_NOT_FOUND;
+    const uint32_t uPage = uCodePoint >> PL__CODEPOINT_PAGE_SHIFT;
+    if(uPage < plu_sb_size(ptFont->sbuCodePointPages) && ptFont->sbuCodePointPages[uPage] != PL__GLYPH_NOT_FOUND)
+        uGlyphIndex = ptFont->sbuCodePoints[ptFont->sbuCodePointPages[uPage] * PL__CODEPOINT_PAGE_SIZE + (uCodePoint & (PL__CODEPOINT_PAGE_SIZE - 1))];
+
+    if(uGlyphIndex == PL__GLYPH_NOT_FOUND)
+        uGlyphIndex = pl__load_dynamic_glyph(ptFont, uCodePoint);
+    if(uGlyphIndex == PL__GLYPH_NOT_FOUND)
+        return NULL;
+
+    const uint32_t uShelf = ptFont->_sbuGlyphShelves[uGlyphIndex];
+    if(uShelf != PL__GLYPH_NOT_FOUND)
+        ptFont->ptParentAtlas->_sbtShelves[uShelf].ulLastUsed = gptCtx ? gptCtx->frameCount : 0;
+    return &ptFont->sbtGlyphs[uGlyphIndex];
 }
 
-void
-pl_cleanup_font_atlas(plFontAtlas* atlas)
+static void
+pl__set_codepoint_glyph(plFont* ptFont, uint32_t uCodePoint, uint32_t uGlyphIndex)
 {
-    for(uint32_t i = 0; i < plu_sb_size(atlas->sbtFonts); i++)
-    {
-        plFont* font = &atlas->sbtFonts[i];
-        plu_sb_free(font->tConfig.sbtRanges);
-        plu_sb_free(font->tConfig.sbiIndividualChars);
-        plu_sb_free(font->sbuCodePoints);
-        plu_sb_free(font->sbtGlyphs);
-        plu_sb_free(font->sbtCharData);
-    }
-    for(uint32_t i = 0; i < plu_sb_size(atlas->_sbtPrepData); i++)
+    const uint32_t uPage = uCodePoint >> PL__CODEPOINT_PAGE_SHIFT;
+    if(uPage >= plu_sb_size(ptFont->sbuCodePointPages))
     {
-        pl_memory_free(atlas->_sbtPrepData[i].ranges);
-        pl_memory_free(atlas->_sbtPrepData[i].rects);
+        const uint32_t uOldPageCount = plu_sb_size(ptFont->sbuCodePointPages);
+        plu_sb_resize(ptFont->sbuCodePointPages, uPage + 1);
+        for(uint32_t i = uOldPageCount; i <= uPage; i++)
+            ptFont->sbuCodePointPages[i] = PL__GLYPH_NOT_FOUND;
     }
-    for(uint32_t i = 0; i < plu_sb_size(atlas->sbtCustomRects); i++)
+    if(ptFont->sbuCodePointPages[uPage] == PL__GLYPH_NOT_FOUND)
     {
-        pl_memory_free(atlas->sbtCustomRects[i].pucBytes);
+        const uint32_t uPageSlot = plu_sb_size(ptFont->sbuCodePoints) / PL__CODEPOINT_PAGE_SIZE;
+        plu_sb_resize(ptFont->sbuCodePoints, (uPageSlot + 1) * PL__CODEPOINT_PAGE_SIZE);
+        for(uint32_t i = 0; i < PL__CODEPOINT_PAGE_SIZE; i++)
+            ptFont->sbuCodePoints[uPageSlot * PL__CODEPOINT_PAGE_SIZE + i] = PL__GLYPH_NOT_FOUND;
+        ptFont->sbuCodePointPages[uPage] = uPageSlot;
     }
-    plu_sb_free(atlas->sbtCustomRects);
-    plu_sb_free(atlas->sbtFonts);
-    plu_sb_free(atlas->_sbtPrepData);
-    pl_memory_free(atlas->pucPixelsAsAlpha8);
-    pl_memory_free(atlas->pucPixelsAsRGBA32);
+    ptFont->sbuCodePoints[ptFont->sbuCodePointPages[uPage] * PL__CODEPOINT_PAGE_SIZE + (uCodePoint & (PL__CODEPOINT_PAGE_SIZE - 1))] = uGlyphIndex;
 }
 
-static void
-pl__prepare_draw_command(plDrawLayer* ptLayer, plTextureId textureID, bool sdf)
+static uint32_t
+pl__load_dynamic_glyph(plFont* ptFont, uint32_t uCodePoint)
 {
-    bool createNewCommand = true;
-
-    const plRect tCurrentClip = plu_sb_size(ptLayer->ptDrawlist->sbtClipStack) > 0 ? plu_sb_top(ptLayer->ptDrawlist->sbtClipStack) : (plRect){0};
+    plFontAtlas* ptAtlas = ptFont->ptParentAtlas;
+    const plFontPrepData* ptPrep = &ptAtlas->_sbtPrepData[ptFont->_uIndex];
+    const plFontConfig* ptConfig = &ptFont->tConfig;
+
+    // missing codepoints get the font's ".notdef" glyph (index 0)
+    const int iGlyph = stbtt_FindGlyphIndex(&ptPrep->fontInfo, (int)uCodePoint);
+
+    // same metrics the static paths produce (pl__generate_sdf_glyphs() &
+    // stbtt_PackFontRangesRenderIntoRects())
+    plFontChar tChar = {0};
+    unsigned char* pucSdf = NULL;
+    int iWidth = 0;
+    int iHeight = 0;
+    int iAdvance = 0;
+    stbtt_GetGlyphHMetrics(&ptPrep->fontInfo, iGlyph, &iAdvance, NULL);
+    if(ptConfig->bSdf)
+    {
+        const float fSdfScale = stbtt_ScaleForPixelHeight(&ptPrep->fontInfo, ptConfig->fFontSize);
+        int iXOff = 0;
+        int iYOff = 0;
+        pucSdf = stbtt_GetGlyphSDF(&ptPrep->fontInfo, fSdfScale, iGlyph, ptConfig->iSdfPadding, ptConfig->ucOnEdgeValue, ptConfig->fSdfPixelDistScale, &iWidth, &iHeight, &iXOff, &iYOff);
+        tChar.xOff = (float)(iXOff);
+        tChar.yOff = (float)(iYOff);
+        tChar.xOff2 = (float)(iXOff + iWidth);
+        tChar.yOff2 = (float)(iYOff + iHeight);
+        tChar.xAdv = ptPrep->scale * (float)iAdvance;
+    }
+    else
+    {
+        const int iHOverSample = (int)ptConfig->uHOverSampling;
+        const int iVOverSample = (int)ptConfig->uVOverSampling;
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = 0;
+        int y1 = 0;
+        stbtt_GetGlyphBitmapBoxSubpixel(&ptPrep->fontInfo, iGlyph, ptPrep->scale * iHOverSample, ptPrep->scale * iVOverSample, 0, 0, &x0, &y0, &x1, &y1);
+        if(x1 > x0 && y1 > y0)
+        {
+            iWidth = x1 - x0 + iHOverSample - 1;
+            iHeight = y1 - y0 + iVOverSample - 1;
+        }
+        const float fSubX = iHOverSample > 1 ? (float)-(iHOverSample - 1) / (2.0f * (float)iHOverSample) : 0.0f;
+        const float fSubY = iVOverSample > 1 ? (float)-(iVOverSample - 1) / (2.0f * (float)iVOverSample) : 0.0f;
+        tChar.xOff = (float)x0 * (1.0f / iHOverSample) + fSubX;
+        tChar.yOff = (float)y0 * (1.0f / iVOverSample) + fSubY;
+        tChar.xOff2 = (x0 + iWidth) * (1.0f / iHOverSample) + fSubX;
+        tChar.yOff2 = (y0 + iHeight) * (1.0f / iVOverSample) + fSubY;
+        tChar.xAdv = ptPrep->scale * iAdvance;
+    }
 
-    
-    if(ptLayer->_ptLastCommand)
+    uint32_t uShelf = PL__GLYPH_NOT_FOUND;
+    if(iWidth > 0 && iHeight > 0)
     {
-        // check if last command has same texture
-        if(ptLayer->_ptLastCommand->tTextureId == textureID && ptLayer->_ptLastCommand->bSdf == sdf)
+        const uint32_t uPadding = (uint32_t)ptAtlas->iGlyphPadding;
+        uint32_t uX = 0;
+        uint32_t uY = 0;
+        uShelf = pl__allocate_dynamic_rect(ptAtlas, (uint32_t)iWidth + uPadding, (uint32_t)iHeight + uPadding, &uX, &uY);
+        if(uShelf == PL__GLYPH_NOT_FOUND) // full of glyphs used this frame, try again next frame
         {
-            createNewCommand = false;
+            if(pucSdf)
+                stbtt_FreeSDF(pucSdf, NULL);
+            return PL__GLYPH_NOT_FOUND;
         }
 
-        // check if last command has same clipping
-        if(ptLayer->_ptLastCommand->tClip.tMax.x != tCurrentClip.tMax.x || ptLayer->_ptLastCommand->tClip.tMax.y != tCurrentClip.tMax.y ||
-            ptLayer->_ptLastCommand->tClip.tMin.x != tCurrentClip.tMin.x || ptLayer->_ptLastCommand->tClip.tMin.y != tCurrentClip.tMin.y)
+        // padding must be clear of whatever was evicted
+        const uint32_t uStride = ptAtlas->auAtlasSize[0];
+        unsigned char* pucDest = &ptAtlas->pucPixelsAsAlpha8[uY * uStride + uX];
+        for(uint32_t i = 0; i < (uint32_t)iHeight + uPadding; i++)
+            memset(&pucDest[i * uStride], 0, (uint32_t)iWidth + uPadding);
+
+        if(pucSdf)
         {
-            createNewCommand = true;
+            for(int i = 0; i < iHeight; i++)
+                memcpy(&pucDest[i * uStride], &pucSdf[i * iWidth], (size_t)iWidth);
+            stbtt_FreeSDF(pucSdf, NULL);
+        }
+        else
+        {
+            float fUnusedX = 0.0f, fUnusedY = 0.0f;
+            stbtt_MakeGlyphBitmapSubpixelPrefilter(&ptPrep->fontInfo, pucDest, iWidth, iHeight, (int)uStride,
+                ptPrep->scale * ptConfig->uHOverSampling, ptPrep->scale * ptConfig->uVOverSampling, 0.0f, 0.0f,
+                (int)ptConfig->uHOverSampling, (int)ptConfig->uVOverSampling, &fUnusedX, &fUnusedY, iGlyph);
         }
+
+        tChar.x0 = (uint16_t)uX;
+        tChar.y0 = (uint16_t)uY;
+        tChar.x1 = (uint16_t)(uX + (uint32_t)iWidth);
+        tChar.y1 = (uint16_t)(uY + (uint32_t)iHeight);
+        pl__add_atlas_dirty_rect(ptAtlas, uX, uY, (uint32_t)iWidth + uPadding, (uint32_t)iHeight + uPadding);
     }
+    else if(pucSdf)
+        stbtt_FreeSDF(pucSdf, NULL);
 
-    // new command needed
-    if(createNewCommand)
+    // reuse an evicted slot if possible
+    const plFontGlyph tGlyph = pl__make_glyph(ptAtlas, ptFont, ptPrep, &tChar, (int)uCodePoint);
+    uint32_t uGlyphIndex = plu_sb_size(ptFont->sbtGlyphs);
+    if(plu_sb_size(ptFont->_sbuFreeGlyphs) > 0)
     {
-        plDrawCommand newdrawCommand = 
-        {
-            .uVertexOffset = plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer),
-            .uIndexOffset  = plu_sb_size(ptLayer->sbuIndexBuffer),
-            .uElementCount = 0u,
-            .tTextureId    = textureID,
-            .bSdf          = sdf,
-            .tClip        = tCurrentClip
-        };
-        plu_sb_push(ptLayer->sbtCommandBuffer, newdrawCommand);
-        
+        uGlyphIndex = plu_sb_pop(ptFont->_sbuFreeGlyphs);
+        ptFont->sbtGlyphs[uGlyphIndex] = tGlyph;
+        ptFont->_sbuGlyphShelves[uGlyphIndex] = uShelf;
+        ptFont->_sbuGlyphCodePoints[uGlyphIndex] = uCodePoint;
     }
-    ptLayer->_ptLastCommand = &plu_sb_top(ptLayer->sbtCommandBuffer);
-    ptLayer->_ptLastCommand->tTextureId = textureID;
+    else
+    {
+        plu_sb_push(ptFont->sbtGlyphs, tGlyph);
+        plu_sb_push(ptFont->_sbuGlyphShelves, uShelf);
+        plu_sb_push(ptFont->_sbuGlyphCodePoints, uCodePoint);
+    }
+    pl__set_codepoint_glyph(ptFont, uCodePoint, uGlyphIndex);
+    return uGlyphIndex;
 }
 
-static void
-pl__reserve_triangles(plDrawLayer* ptLayer, uint32_t indexCount, uint32_t uVertexCount)
+static uint32_t
+pl__allocate_dynamic_rect(plFontAtlas* ptAtlas, uint32_t uWidth, uint32_t uHeight, uint32_t* puX, uint32_t* puY)
 {
-    plu_sb_reserve(ptLayer->ptDrawlist->sbtVertexBuffer, plu_sb_size(ptLayer->ptDrawlist->sbtVertexBuffer) + uVertexCount);
-    plu_sb_reserve(ptLayer->sbuIndexBuffer, plu_sb_size(ptLayer->sbuIndexBuffer) + indexCount);
-    ptLayer->_ptLastCommand->uElementCount += indexCount; 
-    ptLayer->uVertexCount += uVertexCount;
+    if(uWidth + (uint32_t)ptAtlas->iGlyphPadding > ptAtlas->auAtlasSize[0])
+        return PL__GLYPH_NOT_FOUND;
+
+    const uint64_t ulFrame = gptCtx ? gptCtx->frameCount : 0;
+    const uint32_t uShelfCount = plu_sb_size(ptAtlas->_sbtShelves);
+
+    // tightest existing shelf with room
+    uint32_t uBestShelf = PL__GLYPH_NOT_FOUND;
+    for(uint32_t i = 0; i < uShelfCount; i++)
+    {
+        const plFontShelf* ptShelf = &ptAtlas->_sbtShelves[i];
+        if(ptShelf->uHeight < uHeight || ptShelf->uCursorX + uWidth > ptAtlas->auAtlasSize[0])
+            continue;
+        if(uBestShelf == PL__GLYPH_NOT_FOUND || ptShelf->uHeight < ptAtlas->_sbtShelves[uBestShelf].uHeight)
+            uBestShelf = i;
+    }
+
+    // skip shelves much taller than needed while there is still room for a new one
+    const uint32_t uShelfHeight = (uHeight + 3) & ~3u; // rounded so similar glyphs share shelves
+    const uint32_t uNextY = uShelfCount > 0 ? plu_sb_back(ptAtlas->_sbtShelves).uY + plu_sb_back(ptAtlas->_sbtShelves).uHeight : ptAtlas->_uDynamicY;
+    const bool bRoomForShelf = uNextY + uShelfHeight <= ptAtlas->_uDynamicEndY;
+    if(bRoomForShelf && (uBestShelf == PL__GLYPH_NOT_FOUND || ptAtlas->_sbtShelves[uBestShelf].uHeight > uShelfHeight * 2))
+    {
+        const plFontShelf tShelf = {
+            .uY       = uNextY,
+            .uHeight  = uShelfHeight,
+            .uCursorX = (uint32_t)ptAtlas->iGlyphPadding // left gutter, glyphs pad right & bottom
+        };
+        plu_sb_push(ptAtlas->_sbtShelves, tShelf);
+        uBestShelf = uShelfCount;
+    }
+
+    // otherwise recycle the least recently used shelf that is tall enough
+    if(uBestShelf == PL__GLYPH_NOT_FOUND)
+    {
+        for(uint32_t i = 0; i < uShelfCount; i++)
+        {
+            const plFontShelf* ptShelf = &ptAtlas->_sbtShelves[i];
+            if(ptShelf->uHeight < uHeight || ptShelf->ulLastUsed >= ulFrame)
+                continue;
+            if(uBestShelf == PL__GLYPH_NOT_FOUND || ptShelf->ulLastUsed < ptAtlas->_sbtShelves[uBestShelf].ulLastUsed)
+                uBestShelf = i;
+        }
+        if(uBestShelf == PL__GLYPH_NOT_FOUND)
+            return PL__GLYPH_NOT_FOUND;
+        pl__evict_shelf(ptAtlas, uBestShelf);
+    }
+
+    plFontShelf* ptShelf = &ptAtlas->_sbtShelves[uBestShelf];
+    *puX = ptShelf->uCursorX;
+    *puY = ptShelf->uY;
+    ptShelf->uCursorX += uWidth;
+    ptShelf->ulLastUsed = ulFrame;
+    return uBestShelf;
 }
 
 static void
-pl__add_vertex(plDrawLayer* ptLayer, plVec2 pos, plVec4 color, plVec2 uv)
+pl__evict_shelf(plFontAtlas* ptAtlas, uint32_t uShelf)
 {
-
-    uint32_t tcolor = 0;
-    tcolor = (uint32_t)  (255.0f * color.r + 0.5f);
-    tcolor |= (uint32_t) (255.0f * color.g + 0.5f) << 8;
-    tcolor |= (uint32_t) (255.0f * color.b + 0.5f) << 16;
-    tcolor |= (uint32_t) (255.0f * color.a + 0.5f) << 24;
-
-    plu_sb_push(ptLayer->ptDrawlist->sbtVertexBuffer,
-        ((plDrawVertex){
-            .afPos[0] = pos.x,
-            .afPos[1] = pos.y,
-            .afUv[0] = uv.u,
-            .afUv[1] = uv.v,
-            .uColor = tcolor
-        })
-    );
+    for(uint32_t i = 0; i < plu_sb_size(ptAtlas->sbtFonts); i++)
+    {
+        plFont* ptFont = ptAtlas->sbtFonts[i];
+        if(!ptFont->tConfig.bDynamic)
+            continue;
+        for(uint32_t j = 0; j < plu_sb_size(ptFont->_sbuGlyphShelves); j++)
+        {
+            if(ptFont->_sbuGlyphShelves[j] != uShelf)
+                continue;
+            pl__set_codepoint_glyph(ptFont, ptFont->_sbuGlyphCodePoints[j], PL__GLYPH_NOT_FOUND);
+            ptFont->_sbuGlyphShelves[j] = PL__GLYPH_NOT_FOUND;
+            plu_sb_push(ptFont->_sbuFreeGlyphs, j);
+        }
+    }
+    ptAtlas->_sbtShelves[uShelf].uCursorX = (uint32_t)ptAtlas->iGlyphPadding;
+    ptAtlas->_uEvictions++;
 }
 
 static void
-pl__add_index(plDrawLayer* ptLayer, uint32_t vertexStart, uint32_t i0, uint32_t i1, uint32_t i2)
+pl__add_atlas_dirty_rect(plFontAtlas* ptAtlas, uint32_t uX, uint32_t uY, uint32_t uWidth, uint32_t uHeight)
 {
-    plu_sb_push(ptLayer->sbuIndexBuffer, vertexStart + i0);
-    plu_sb_push(ptLayer->sbuIndexBuffer, vertexStart + i1);
-    plu_sb_push(ptLayer->sbuIndexBuffer, vertexStart + i2);
+    // keep the RGBA copy in sync (if there is one)
+    if(ptAtlas->pucPixelsAsRGBA32)
+    {
+        for(uint32_t i = uY; i < uY + uHeight; i++)
+        {
+            const size_t szRowStart = (size_t)i * ptAtlas->auAtlasSize[0] + uX;
+            pl__expand_alpha_to_rgba(&ptAtlas->pucPixelsAsRGBA32[szRowStart * 4], &ptAtlas->pucPixelsAsAlpha8[szRowStart], uWidth);
+        }
+    }
+
+    // glyphs are allocated left to right along a shelf, so neighbours merge
+    if(plu_sb_size(ptAtlas->sbtDirtyRects) > 0)
+    {
+        plFontAtlasRect* ptLast = &plu_sb_back(ptAtlas->sbtDirtyRects);
+        if(ptLast->uY == uY && ptLast->uX + ptLast->uWidth == uX)
+        {
+            ptLast->uWidth += uWidth;
+            ptLast->uHeight = plu_max(ptLast->uHeight, uHeight);
+            return;
+        }
+    }
+    const plFontAtlasRect tRect = {
+        .uX      = uX,
+        .uY      = uY,
+        .uWidth  = uWidth,
+        .uHeight = uHeight
+    };
+    plu_sb_push(ptAtlas->sbtDirtyRects, tRect);
 }
 
 static char*
-plu__read_file(const char* file)
+plu__read_file(const char* file, size_t* pszSize)
 {
+    *pszSize = 0;
     FILE* fileHandle = fopen(file, "rb");
 
     if(fileHandle == NULL)
@@ -1497,15 +3230,95 @@ plu__read_file(const char* file)
         }
         assert(false && "TTF file not read.");
     }
+    *pszSize = result;
 
     fclose(fileHandle);
     return data;
 }
 
+static unsigned char*
+pl__map_file(const char* pcFile, size_t* pszSize)
+{
+    *pszSize = 0;
+#if defined(PL_UI_NO_FILE_MAPPING)
+    (void)pcFile;
+    return NULL;
+#elif defined(_WIN32)
+    HANDLE tFile = CreateFileA(pcFile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(tFile == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    LARGE_INTEGER tFileSize = {0};
+    if(!GetFileSizeEx(tFile, &tFileSize) || tFileSize.QuadPart == 0)
+    {
+        CloseHandle(tFile);
+        return NULL;
+    }
+
+    // the view keeps the mapping (and file) alive once the handles are closed
+    HANDLE tMapping = CreateFileMappingA(tFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(tFile);
+    if(tMapping == NULL)
+        return NULL;
+    unsigned char* pucData = MapViewOfFile(tMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(tMapping);
+    if(pucData == NULL)
+        return NULL;
+    *pszSize = (size_t)tFileSize.QuadPart;
+    return pucData;
+#else
+    const int iFile = open(pcFile, O_RDONLY);
+    if(iFile < 0)
+        return NULL;
+
+    struct stat tStat;
+    if(fstat(iFile, &tStat) != 0 || tStat.st_size <= 0)
+    {
+        close(iFile);
+        return NULL;
+    }
+
+    // the mapping outlives the descriptor
+    void* pData = mmap(NULL, (size_t)tStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+    close(iFile);
+    if(pData == MAP_FAILED)
+        return NULL;
+    *pszSize = (size_t)tStat.st_size;
+    return pData;
+#endif
+}
+
+static void
+pl__release_font_data(plFontPrepData* ptPrep)
+{
+    if(ptPrep->ptrTtf == NULL)
+        return;
+
+    if(ptPrep->szMappedSize > 0)
+    {
+    #if defined(_WIN32) && !defined(PL_UI_NO_FILE_MAPPING)
+        UnmapViewOfFile(ptPrep->ptrTtf);
+    #elif !defined(PL_UI_NO_FILE_MAPPING)
+        munmap(ptPrep->ptrTtf, ptPrep->szMappedSize);
+    #endif
+    }
+    else
+        pl_memory_free(ptPrep->ptrTtf);
+    ptPrep->ptrTtf = NULL;
+    ptPrep->szMappedSize = 0;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] default font stuff
 //-----------------------------------------------------------------------------
 
+// optional prebuilt atlas for the default font. examples/example_bake_font_atlas
+// generates it (build.sh writes examples/out/pl_ui_default_atlas.inl), then
+// compile with PL_UI_BAKED_DEFAULT_ATLAS="\"pl_ui_default_atlas.inl\"".
+#ifdef PL_UI_BAKED_DEFAULT_ATLAS
+    #include PL_UI_BAKED_DEFAULT_ATLAS
+#endif
+
 static uint32_t
 pl__decompress_length(const unsigned char* ptrInput)
 {
@@ -1742,22 +3555,10 @@ static const char gcPtrDefaultFontCompressed[11980 + 1] =
     "GT4CPGT4CPGT4CPGT4CPGT4CPGT4CP-qekC`.9kEg^+F$kwViFJTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5KTB&5o,^<-28ZI'O?;xp"
     "O?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xpO?;xp;7q-#lLYI:xvD=#";
 
-void
+plFont*
 pl_add_default_font(plFontAtlas* ptrAtlas)
 {
     static const char* cPtrEmbeddedFontName = "Proggy.ttf";
-    
-    void* data = NULL;
-
-    int iCompressedTTFSize = (((int)strlen(gcPtrDefaultFontCompressed) + 4) / 5) * 4;
-    void* ptrCompressedTTF = pl_memory_alloc((size_t)iCompressedTTFSize);
-    pl__decode85((const unsigned char*)gcPtrDefaultFontCompressed, (unsigned char*)ptrCompressedTTF);
-
-    const uint32_t uDecompressedSize = pl__decompress_length((const unsigned char*)ptrCompressedTTF);
-    data = (unsigned char*)pl_memory_alloc(uDecompressedSize);
-    pl__decompress((unsigned char*)data, (const unsigned char*)ptrCompressedTTF, (int)iCompressedTTFSize);
-
-    pl_memory_free(ptrCompressedTTF);
 
     plFontConfig fontConfig = {
         .bSdf = false,
@@ -1773,7 +3574,34 @@ pl_add_default_font(plFontAtlas* ptrAtlas)
         .uCharCount = 0x00FF - 0x0020
     };
     plu_sb_push(fontConfig.sbtRanges, range);
-    pl_add_font_from_memory_ttf(ptrAtlas, fontConfig, data);
+    plFont* ptFont = pl__add_font(ptrAtlas, fontConfig, NULL, 0, false, gcPtrDefaultFontCompressed);
+
+#ifdef PL_UI_BAKED_DEFAULT_ATLAS
+    // only used while this is the only font (the key check rejects it otherwise).
+    // pixels are used in place, but unless bAlpha8Only is set the build still
+    // allocates & expands the RGBA32 copy, so near zero startup needs bAlpha8Only
+    if(ptrAtlas->pucBakedData == NULL)
+    {
+        ptrAtlas->pucBakedData = gauPlBakedDefaultAtlas;
+        ptrAtlas->szBakedDataSize = sizeof(gauPlBakedDefaultAtlas);
+    }
+#endif
+    return ptFont;
+}
+
+static unsigned char*
+pl__decompress_default_font(const char* pcCompressedTtf)
+{
+    int iCompressedTTFSize = (((int)strlen(pcCompressedTtf) + 4) / 5) * 4;
+    void* ptrCompressedTTF = pl_memory_alloc((size_t)iCompressedTTFSize);
+    pl__decode85((const unsigned char*)pcCompressedTtf, (unsigned char*)ptrCompressedTTF);
+
+    const uint32_t uDecompressedSize = pl__decompress_length((const unsigned char*)ptrCompressedTTF);
+    unsigned char* data = (unsigned char*)pl_memory_alloc(uDecompressedSize);
+    pl__decompress(data, (const unsigned char*)ptrCompressedTTF, (int)iCompressedTTFSize);
+
+    pl_memory_free(ptrCompressedTTF);
+    return data;
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,94 @@
+// pilotlight ui - compile time ids (C++11)
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] internal
+// [SECTION] public api
+*/
+
+/*
+    Computes the same ids as "pl_get_id_ex()" (CRC32 of the label seeded with the
+    parent id, anything before the last "###" ignored) so they can be passed to the
+    "*_id" widget variants without hashing at runtime.
+
+        constexpr plUiId tWindowId = pl_ui_id("Settings");           // top level window
+        constexpr plUiId tApplyId  = pl_ui_id("Apply", tWindowId);  // == pl_get_id("Apply") inside "Settings"
+
+        if(pl_begin_window("Settings", nullptr, 0))
+        {
+            if(pl_button_id(tApplyId, "Apply")) { ... }
+            pl_end_window();
+        }
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_UI_ID_HPP
+#define PL_UI_ID_HPP
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stddef.h> // size_t
+#include "pl_ui.h"  // plUiId
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal
+//-----------------------------------------------------------------------------
+
+// single expression recursion so this works with C++11 constexpr rules
+// (recursion depth follows the label length, so keep labels well below ~500 chars)
+namespace pl_ui_id_internal
+{
+
+constexpr uint32_t
+crc32_bits(uint32_t uCrc, int iBits)
+{
+    return iBits == 0 ? uCrc : crc32_bits((uCrc >> 1) ^ (0xEDB88320u & (0u - (uCrc & 1u))), iBits - 1);
+}
+
+constexpr uint32_t
+crc32(const char* pcData, size_t szIndex, size_t szEnd, uint32_t uCrc)
+{
+    return szIndex == szEnd ? uCrc : crc32(pcData, szIndex + 1, szEnd, crc32_bits(uCrc ^ (unsigned char)pcData[szIndex], 8));
+}
+
+constexpr size_t
+length(const char* pcData, size_t szIndex)
+{
+    return pcData[szIndex] == 0 ? szIndex : length(pcData, szIndex + 1);
+}
+
+// start of the last "###" (or 0)
+constexpr size_t
+id_start(const char* pcData, size_t szIndex, size_t szEnd, size_t szStart)
+{
+    return szIndex + 3 > szEnd ? szStart :
+        id_start(pcData, szIndex + 1, szEnd, (pcData[szIndex] == '#' && pcData[szIndex + 1] == '#' && pcData[szIndex + 2] == '#') ? szIndex : szStart);
+}
+
+constexpr plUiId
+hash(const char* pcLabel, size_t szEnd, plUiId tParentId)
+{
+    return ~crc32(pcLabel, id_start(pcLabel, 0, szEnd, 0), szEnd, ~tParentId);
+}
+
+} // namespace pl_ui_id_internal
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api
+//-----------------------------------------------------------------------------
+
+// same result as "pl_get_id_ex(pcLabel, tParentId)"
+constexpr plUiId
+pl_ui_id(const char* pcLabel, plUiId tParentId = 0)
+{
+    return pl_ui_id_internal::hash(pcLabel, pl_ui_id_internal::length(pcLabel, 0), tParentId);
+}
+
+#endif // PL_UI_ID_HPP
@@ -43,6 +43,14 @@ Index of this file:
 #include <math.h>
 #include "pl_ui.h"
 
+#if defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h> // __crc32d, __crc32b
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h> // _InterlockedIncrement, _InterlockedDecrement
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] helper macros
 //-----------------------------------------------------------------------------
@@ -51,6 +59,15 @@ Index of this file:
 #define plu_vsprintf vsprintf
 #define plu_vnsprintf vsnprintf
 
+// relaxed counters (layers may grow their buffers on any thread)
+#if defined(_MSC_VER)
+    #define plu_atomic_increment(puValue) _InterlockedIncrement((volatile long*)(puValue))
+    #define plu_atomic_decrement(puValue) _InterlockedDecrement((volatile long*)(puValue))
+#else
+    #define plu_atomic_increment(puValue) __atomic_add_fetch((puValue), 1u, __ATOMIC_RELAXED)
+    #define plu_atomic_decrement(puValue) __atomic_sub_fetch((puValue), 1u, __ATOMIC_RELAXED)
+#endif
+
 #ifndef PL_UI_ASSERT
     #include <assert.h>
     #define PL_UI_ASSERT(x) assert((x))
@@ -77,6 +94,21 @@ Index of this file:
 #define PLU_PI_2 1.57079632f // pi/2
 #define PLU_2PI  6.28318530f // pi
 
+// text layout cache (set associative, LRU within a set)
+#ifndef PL_UI_TEXT_CACHE_SETS
+    #define PL_UI_TEXT_CACHE_SETS 64 // must be a power of 2
+#endif
+#define PL_UI_TEXT_CACHE_WAYS 4
+
+// state storage (entries per page, pages are allocated as needed)
+#ifndef PL_UI_STORAGE_PAGE_SIZE
+    #define PL_UI_STORAGE_PAGE_SIZE 64
+#endif
+
+// circle tessellation (automatic segment counts are rounded up to even)
+#define PL_UI_CIRCLE_SEGMENTS_MIN 4
+#define PL_UI_CIRCLE_SEGMENTS_MAX 512
+
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations
 //-----------------------------------------------------------------------------
@@ -84,6 +116,7 @@ Index of this file:
 // basic types
 typedef struct _plUiStyle          plUiStyle;
 typedef union  _plUiColorScheme    plUiColorScheme;
+typedef union  _plUiPackedColorScheme plUiPackedColorScheme;
 typedef struct _plUiColorStackItem plUiColorStackItem;
 typedef struct _plUiWindow         plUiWindow;
 typedef struct _plUiTabBar         plUiTabBar;
@@ -92,7 +125,10 @@ typedef struct _plUiNextWindowData plUiNextWindowData;
 typedef struct _plUiTempWindowData plUiTempWindowData;
 typedef struct _plUiStorage        plUiStorage;
 typedef struct _plUiStorageEntry   plUiStorageEntry;
+typedef struct _plUiStorageSlot    plUiStorageSlot;
 typedef struct _plUiInputTextState plUiInputTextState;
+typedef struct _plUiTextGlyph      plUiTextGlyph;
+typedef struct _plUiTextLayout     plUiTextLayout;
 
 // enums
 typedef int plUiNextWindowFlags;
@@ -245,6 +281,9 @@ static inline plRect plu_rect_move_center_x (const plRect* ptRect, float fX)
 static inline plRect plu_rect_move_start    (const plRect* ptRect, float fX, float fY)         { const plRect tResult = {{ fX, fY}, { fX + ptRect->tMax.x - ptRect->tMin.x, fY + ptRect->tMax.y - ptRect->tMin.y} }; return tResult;}
 static inline plRect plu_rect_move_start_x  (const plRect* ptRect, float fX)                   { const plRect tResult = { { fX, ptRect->tMin.y}, { fX + ptRect->tMax.x - ptRect->tMin.x, ptRect->tMax.y} }; return tResult;}
 
+// color ops (RGBA8, r in the low byte)
+static inline uint32_t plu_pack_color(plVec4 tColor) { return (uint32_t)(255.0f * tColor.r + 0.5f) | (uint32_t)(255.0f * tColor.g + 0.5f) << 8 | (uint32_t)(255.0f * tColor.b + 0.5f) << 16 | (uint32_t)(255.0f * tColor.a + 0.5f) << 24; }
+
 #define PLU_VEC2_LENGTH_SQR(vec) (((vec).x * (vec).x) + ((vec).y * (vec).y))
 
 //-----------------------------------------------------------------------------
@@ -266,13 +305,18 @@ plu__sb_grow(void** ptrBuffer, size_t szElementSize, size_t szNewItems)
 
     plUiSbHeader_* ptOldHeader = plu__sb_header(*ptrBuffer);
 
-    const size_t szNewSize = (ptOldHeader->uCapacity + szNewItems) * szElementSize + sizeof(plUiSbHeader_);
+    // grow geometrically so repeated pushes are amortized O(1)
+    uint32_t uNewCapacity = ptOldHeader->uCapacity * 2u;
+    if(uNewCapacity < ptOldHeader->uSize + (uint32_t)szNewItems)
+        uNewCapacity = ptOldHeader->uSize + (uint32_t)szNewItems;
+
+    const size_t szNewSize = uNewCapacity * szElementSize + sizeof(plUiSbHeader_);
     plUiSbHeader_* ptNewHeader = (plUiSbHeader_*)pl_memory_alloc(szNewSize); //-V592
-    memset(ptNewHeader, 0, (ptOldHeader->uCapacity + szNewItems) * szElementSize + sizeof(plUiSbHeader_));
+    memset(ptNewHeader, 0, szNewSize);
     if(ptNewHeader)
     {
         ptNewHeader->uSize = ptOldHeader->uSize;
-        ptNewHeader->uCapacity = ptOldHeader->uCapacity + (uint32_t)szNewItems;
+        ptNewHeader->uCapacity = uNewCapacity;
         memcpy(&ptNewHeader[1], *ptrBuffer, ptOldHeader->uSize * szElementSize);
         pl_memory_free(ptOldHeader);
         *ptrBuffer = &ptNewHeader[1];
@@ -292,6 +336,8 @@ plu__sb_may_grow_(void** ptrBuffer, size_t szElementSize, size_t szNewItems, siz
     }
     else // first run
     {
+        if(szMinCapacity < szNewItems)
+            szMinCapacity = szNewItems;
         const size_t szNewSize = szMinCapacity * szElementSize + sizeof(plUiSbHeader_);
         plUiSbHeader_* ptHeader = (plUiSbHeader_*)pl_memory_alloc(szNewSize);
         memset(ptHeader, 0, szMinCapacity * szElementSize + sizeof(plUiSbHeader_));
@@ -304,6 +350,15 @@ plu__sb_may_grow_(void** ptrBuffer, size_t szElementSize, size_t szNewItems, siz
     }     
 }
 
+// ensures capacity for szCapacity items total (not in addition to the current size)
+static void
+plu__sb_reserve_(void** ptrBuffer, size_t szElementSize, size_t szCapacity)
+{
+    const uint32_t uSize = *ptrBuffer ? plu__sb_header(*ptrBuffer)->uSize : 0u;
+    if(*ptrBuffer == NULL || szCapacity > uSize)
+        plu__sb_may_grow_(ptrBuffer, szElementSize, szCapacity - uSize, szCapacity);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] stretchy buffer
 //-----------------------------------------------------------------------------
@@ -354,10 +409,10 @@ plu__sb_may_grow_(void** ptrBuffer, size_t szElementSize, size_t szNewItems, siz
     (plu__sb_may_grow((buf), sizeof(*(buf)), 1, 8), (buf)[plu__sb_header((buf))->uSize++] = (v))
 
 #define plu_sb_reserve(buf, n) \
-    (plu__sb_may_grow((buf), sizeof(*(buf)), (n), (n)))
+    (plu__sb_reserve_((void**)&(buf), sizeof(*(buf)), (n)))
 
 #define plu_sb_resize(buf, n) \
-    (plu__sb_may_grow((buf), sizeof(*(buf)), (n), (n)), plu__sb_header((buf))->uSize = (n))
+    (plu__sb_reserve_((void**)&(buf), sizeof(*(buf)), (n)), plu__sb_header((buf))->uSize = (n))
 
 #define plu_sb_del_n(buf, i, n) \
     (memmove(&(buf)[i], &(buf)[(i) + (n)], sizeof *(buf) * (plu__sb_header(buf)->uSize - (n) - (i))), plu__sb_header(buf)->uSize -= (n))
@@ -479,9 +534,41 @@ typedef union _plUiColorScheme
         plVec4 tScrollbarActiveCol;
         plVec4 tScrollbarHoveredCol;
     };
-    plVec4 atColors[23];
+    plVec4 atColors[PL_UI_COLOR_COUNT];
 } plUiColorScheme;
 
+// packed copy of plUiColorScheme (kept in sync by pl_set_dark_theme & pl_push/pop_theme_color)
+typedef union _plUiPackedColorScheme
+{
+    struct 
+    {
+        uint32_t uTitleActiveCol;
+        uint32_t uTitleBgCol;
+        uint32_t uTitleBgCollapsedCol;
+        uint32_t uWindowBgColor;
+        uint32_t uWindowBorderColor;
+        uint32_t uChildBgColor;
+        uint32_t uButtonCol;
+        uint32_t uButtonHoveredCol;
+        uint32_t uButtonActiveCol;
+        uint32_t uTextCol;
+        uint32_t uProgressBarCol;
+        uint32_t uCheckmarkCol;
+        uint32_t uFrameBgCol;
+        uint32_t uFrameBgHoveredCol;
+        uint32_t uFrameBgActiveCol;
+        uint32_t uHeaderCol;
+        uint32_t uHeaderHoveredCol;
+        uint32_t uHeaderActiveCol;
+        uint32_t uScrollbarBgCol;
+        uint32_t uScrollbarHandleCol;
+        uint32_t uScrollbarFrameCol;
+        uint32_t uScrollbarActiveCol;
+        uint32_t uScrollbarHoveredCol;
+    };
+    uint32_t auColors[PL_UI_COLOR_COUNT];
+} plUiPackedColorScheme;
+
 typedef struct _plUiStyle
 {
     // style
@@ -513,6 +600,34 @@ typedef struct _plUiPrevItemData
     bool bActive;
 } plUiPrevItemData;
 
+typedef struct _plUiTextGlyph
+{
+    plVec2   tMin;       // quad top-left (relative to text origin)
+    plVec2   tMax;       // quad bottom-right (relative to text origin)
+    plVec2   tUvMin;
+    plVec2   tUvMax;
+    plVec2   tPen;       // pen position after advancing past this glyph (used for clipping)
+    uint32_t uCodePoint; // dynamic fonts touch their glyphs again on cache hits
+} plUiTextGlyph;
+
+typedef struct _plUiTextLayout
+{
+    // key
+    plFont*        ptFont;      // NULL if slot is unused
+    float          fSize;
+    float          fWrap;       // <= 0.0f stored as 0.0f
+    uint32_t       uHash;       // text hash seeded with font, size & wrap (only a prefilter)
+    uint32_t       uTextLength;
+    char*          sbcText;     // copy of the text, compared on hits (capacity retained on eviction)
+    uint32_t       uEvictions;  // atlas eviction count when built (dynamic fonts only)
+
+    // value
+    uint64_t       ulLastUsed;  // cache tick of last lookup (for LRU eviction)
+    plVec2         tSize;       // pl_calculate_text_size_ex() result
+    plVec2         tBBOffset;   // pl_calculate_text_bb_ex() min relative to tP
+    plUiTextGlyph* sbtGlyphs;   // visible glyphs relative to origin (capacity retained on eviction)
+} plUiTextLayout;
+
 typedef struct _plUiLayoutSortLevel
 {
     float    fWidth;
@@ -582,9 +697,19 @@ typedef struct _plUiStorageEntry
     };
 } plUiStorageEntry;
 
+typedef struct _plUiStorageSlot
+{
+    uint32_t uKey;
+    uint32_t uIndex; // entry index (UINT32_MAX if empty)
+} plUiStorageSlot;
+
+// open addressing hash map (linear probing) keyed by id; entries live in
+// fixed size pages & never move, so pl_get_*_ptr() pointers stay valid
 typedef struct _plUiStorage
 {
-    plUiStorageEntry* sbtData;
+    plUiStorageSlot*   sbtSlots; // power of 2 size
+    plUiStorageEntry** sbtPages; // PL_UI_STORAGE_PAGE_SIZE entries each
+    uint32_t           uCount;
 } plUiStorage;
 
 //-----------------------------------------------------------------------------
@@ -664,8 +789,9 @@ typedef struct _plUiNextWindowData
 
 typedef struct _plUiContext
 {
-    plUiStyle       tStyle;
-    plUiColorScheme tColorScheme;
+    plUiStyle             tStyle;
+    plUiColorScheme       tColorScheme;
+    plUiPackedColorScheme tPackedColorScheme; // tColorScheme converted once for the draw calls
     plIO            tIO;
     
     // prev/next state
@@ -719,6 +845,11 @@ typedef struct _plUiContext
     plFontAtlas*   fontAtlas;
     plVec2         tFrameBufferScale;
 
+    // circle tessellation (built by pl__update_circle_tables, read only while drawing)
+    float          fCircleSegmentMaxError;    // max error auCircleSegmentCounts was built with
+    uint16_t       auCircleSegmentCounts[64]; // automatic segment counts for integer radii
+    plVec2*        sbtArcTable;               // unit circle points (cos, sin) for even segment counts (see pl__arc_table_offset)
+
     // logging
     bool            bLogActive;
     char*           sbcLogBuffer;
@@ -729,8 +860,16 @@ typedef struct _plUiContext
     float fConfigFileDirtyTimer; // write out to disk when this reaches zero
     char* sbcConfigFileData;
 
-    // memory
-    uint32_t uMemoryAllocations;
+    // memory (updated atomically, see pl_memory_alloc)
+    uint32_t uMemoryAllocations;          // live allocations
+    uint32_t uFrameMemoryAllocations;     // allocations made so far this frame
+    uint32_t uLastFrameMemoryAllocations; // allocations made during the previous frame (0 in steady state)
+
+    // text layout cache
+    plUiTextLayout atTextCache[PL_UI_TEXT_CACHE_SETS * PL_UI_TEXT_CACHE_WAYS];
+    uint64_t       ulTextCacheTick;
+    uint32_t       uTextCacheHits;
+    uint32_t       uTextCacheMisses;
 
 } plUiContext;
 
@@ -749,6 +888,7 @@ const char*          pl_find_renderered_text_end(const char* pcText, const char*
 void                 pl_ui_add_text             (plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP, plVec4 tColor, const char* pcText, float fWrap);
 void                 pl_add_clipped_text        (plDrawLayer* ptLayer, plFont* ptFont, float fSize, plVec2 tP, plVec2 tMin, plVec2 tMax, plVec4 tColor, const char* pcText, float fWrap);
 plVec2               pl_ui_calculate_text_size     (plFont* font, float size, const char* text, float wrap);
+plRect               pl_ui_calculate_text_bb    (plFont* ptFont, float fSize, plVec2 tP, const char* pcText, float fWrap);
 static inline float  pl_get_frame_height        (void) { return gptCtx->tStyle.fFontSize + gptCtx->tStyle.tFramePadding.y * 2.0f; }
 
 // collision
@@ -761,6 +901,9 @@ static inline plVec2 pl__ui_get_cursor_pos    (void) { return (plVec2){gptCtx->p
 plVec2               pl_calculate_item_size(float fDefaultHeight);
 void                 pl_advance_cursor     (float fWidth, float fHeight);
 
+// drawing (main thread, before any layer is filled)
+void pl__update_circle_tables(void);
+
 // misc
 bool pl_begin_window_ex (const char* pcName, bool* pbOpen, plUiWindowFlags tFlags);
 void pl_render_scrollbar(plUiWindow* ptWindow, uint32_t uHash, plUiAxis tAxis);
@@ -786,13 +929,54 @@ static inline int  pl__text_state_undo_avail_count(plUiInputTextState* ptState)
 static inline int  pl__text_state_redo_avail_count(plUiInputTextState* ptState)           { return STB_TEXTEDIT_UNDOSTATECOUNT - ptState->tStb.undostate.redo_point; }
 static void        pl__text_state_on_key_press    (plUiInputTextState* ptState, int iKey);
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~fonts~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// two level codepoint -> glyph table (pages are only allocated where glyphs exist)
+#define PL__GLYPH_NOT_FOUND       UINT32_MAX
+#define PL__CODEPOINT_PAGE_SHIFT  8
+#define PL__CODEPOINT_PAGE_SIZE   (1u << PL__CODEPOINT_PAGE_SHIFT)
+
+// rasterizes on first use & marks the glyph as used this frame
+const plFontGlyph* pl__find_dynamic_glyph(plFont* ptFont, uint32_t uCodePoint);
+
+static inline const plFontGlyph*
+pl__find_glyph(const plFont* ptFont, uint32_t uCodePoint)
+{
+    if(ptFont->tConfig.bDynamic)
+        return pl__find_dynamic_glyph((plFont*)ptFont, uCodePoint);
+    const uint32_t uPage = uCodePoint >> PL__CODEPOINT_PAGE_SHIFT;
+    if(uPage >= plu_sb_size(ptFont->sbuCodePointPages) || ptFont->sbuCodePointPages[uPage] == PL__GLYPH_NOT_FOUND)
+        return NULL;
+    const uint32_t uGlyphIndex = ptFont->sbuCodePoints[ptFont->sbuCodePointPages[uPage] * PL__CODEPOINT_PAGE_SIZE + (uCodePoint & (PL__CODEPOINT_PAGE_SIZE - 1))];
+    return uGlyphIndex == PL__GLYPH_NOT_FOUND ? NULL : &ptFont->sbtGlyphs[uGlyphIndex];
+}
+
+static inline float
+pl__glyph_advance(const plFont* ptFont, uint32_t uCodePoint)
+{
+    const plFontGlyph* ptGlyph = pl__find_glyph(ptFont, uCodePoint);
+    return ptGlyph ? ptGlyph->xAdvance : 0.0f;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~text layout cache~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// returned layout is only valid until the next lookup
+const plUiTextLayout* pl__get_text_layout      (plFont* ptFont, float fSize, const char* pcText, const char* pcTextEnd, float fWrap);
+void                  pl__add_text_layout      (plDrawLayer* ptLayer, const plUiTextLayout* ptLayout, plVec2 tP, plVec4 tColor, const plRect* ptClipRect);
+void                  pl__invalidate_text_cache(void);
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~jobs~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// runs through plIO::ptJobSystem when set, otherwise serially (matches plJobDispatch)
+void pl__dispatch_jobs(plJobFunction tFunction, void* pData, uint32_t uJobCount, void* pUserData);
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~widget behavior~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 bool pl_button_behavior(const plRect* ptBox, uint32_t uHash, bool* pbOutHovered, bool* pbOutHeld);
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~storage system~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-plUiStorageEntry*    pl_lower_bound(plUiStorageEntry* sbtData, uint32_t uKey);
+void                 pl_cleanup_storage(plUiStorage* ptStorage);
 
 int                  pl_get_int      (plUiStorage* ptStorage, uint32_t uKey, int iDefaultValue);
 float                pl_get_float    (plUiStorage* ptStorage, uint32_t uKey, float fDefaultValue);
@@ -809,70 +993,73 @@ void                 pl_set_float    (plUiStorage* ptStorage, uint32_t uKey, flo
 void                 pl_set_bool     (plUiStorage* ptStorage, uint32_t uKey, bool bValue);
 void                 pl_set_ptr      (plUiStorage* ptStorage, uint32_t uKey, void* pValue);
 
-// (borrowed from Dear ImGui)
-// CRC32 needs a 1KB lookup table (not cache friendly)
-static const uint32_t gauiCrc32LUT[256] =
-{
-    0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
-    0x1DB71064,0x6AB020F2,0xF3B97148,0x84BE41DE,0x1ADAD47D,0x6DDDE4EB,0xF4D4B551,0x83D385C7,0x136C9856,0x646BA8C0,0xFD62F97A,0x8A65C9EC,0x14015C4F,0x63066CD9,0xFA0F3D63,0x8D080DF5,
-    0x3B6E20C8,0x4C69105E,0xD56041E4,0xA2677172,0x3C03E4D1,0x4B04D447,0xD20D85FD,0xA50AB56B,0x35B5A8FA,0x42B2986C,0xDBBBC9D6,0xACBCF940,0x32D86CE3,0x45DF5C75,0xDCD60DCF,0xABD13D59,
-    0x26D930AC,0x51DE003A,0xC8D75180,0xBFD06116,0x21B4F4B5,0x56B3C423,0xCFBA9599,0xB8BDA50F,0x2802B89E,0x5F058808,0xC60CD9B2,0xB10BE924,0x2F6F7C87,0x58684C11,0xC1611DAB,0xB6662D3D,
-    0x76DC4190,0x01DB7106,0x98D220BC,0xEFD5102A,0x71B18589,0x06B6B51F,0x9FBFE4A5,0xE8B8D433,0x7807C9A2,0x0F00F934,0x9609A88E,0xE10E9818,0x7F6A0DBB,0x086D3D2D,0x91646C97,0xE6635C01,
-    0x6B6B51F4,0x1C6C6162,0x856530D8,0xF262004E,0x6C0695ED,0x1B01A57B,0x8208F4C1,0xF50FC457,0x65B0D9C6,0x12B7E950,0x8BBEB8EA,0xFCB9887C,0x62DD1DDF,0x15DA2D49,0x8CD37CF3,0xFBD44C65,
-    0x4DB26158,0x3AB551CE,0xA3BC0074,0xD4BB30E2,0x4ADFA541,0x3DD895D7,0xA4D1C46D,0xD3D6F4FB,0x4369E96A,0x346ED9FC,0xAD678846,0xDA60B8D0,0x44042D73,0x33031DE5,0xAA0A4C5F,0xDD0D7CC9,
-    0x5005713C,0x270241AA,0xBE0B1010,0xC90C2086,0x5768B525,0x206F85B3,0xB966D409,0xCE61E49F,0x5EDEF90E,0x29D9C998,0xB0D09822,0xC7D7A8B4,0x59B33D17,0x2EB40D81,0xB7BD5C3B,0xC0BA6CAD,
-    0xEDB88320,0x9ABFB3B6,0x03B6E20C,0x74B1D29A,0xEAD54739,0x9DD277AF,0x04DB2615,0x73DC1683,0xE3630B12,0x94643B84,0x0D6D6A3E,0x7A6A5AA8,0xE40ECF0B,0x9309FF9D,0x0A00AE27,0x7D079EB1,
-    0xF00F9344,0x8708A3D2,0x1E01F268,0x6906C2FE,0xF762575D,0x806567CB,0x196C3671,0x6E6B06E7,0xFED41B76,0x89D32BE0,0x10DA7A5A,0x67DD4ACC,0xF9B9DF6F,0x8EBEEFF9,0x17B7BE43,0x60B08ED5,
-    0xD6D6A3E8,0xA1D1937E,0x38D8C2C4,0x4FDFF252,0xD1BB67F1,0xA6BC5767,0x3FB506DD,0x48B2364B,0xD80D2BDA,0xAF0A1B4C,0x36034AF6,0x41047A60,0xDF60EFC3,0xA867DF55,0x316E8EEF,0x4669BE79,
-    0xCB61B38C,0xBC66831A,0x256FD2A0,0x5268E236,0xCC0C7795,0xBB0B4703,0x220216B9,0x5505262F,0xC5BA3BBE,0xB2BD0B28,0x2BB45A92,0x5CB36A04,0xC2D7FFA7,0xB5D0CF31,0x2CD99E8B,0x5BDEAE1D,
-    0x9B64C2B0,0xEC63F226,0x756AA39C,0x026D930A,0x9C0906A9,0xEB0E363F,0x72076785,0x05005713,0x95BF4A82,0xE2B87A14,0x7BB12BAE,0x0CB61B38,0x92D28E9B,0xE5D5BE0D,0x7CDCEFB7,0x0BDBDF21,
-    0x86D3D2D4,0xF1D4E242,0x68DDB3F8,0x1FDA836E,0x81BE16CD,0xF6B9265B,0x6FB077E1,0x18B74777,0x88085AE6,0xFF0F6A70,0x66063BCA,0x11010B5C,0x8F659EFF,0xF862AE69,0x616BFFD3,0x166CCF45,
-    0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
-    0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
-};
+// CRC32 (same polynomial & ids as Dear ImGui), processed 8 bytes at a time
+// through slice-by-8 tables (defined in pl_ui.c, [0] is the classic 1KB table)
+extern const uint32_t gauiCrc32LUT[8][256];
+
+// raw crc update (no pre/post inversion)
+static inline uint32_t
+plu__crc32(uint32_t uCrc, const unsigned char* pucData, size_t szDataSize)
+{
+#if defined(__ARM_FEATURE_CRC32)
+    // ARMv8 crc32 instructions use this polynomial (unlike x86 SSE4.2 which is CRC32-C)
+    for(; szDataSize >= 8; szDataSize -= 8, pucData += 8)
+    {
+        uint64_t ulWord;
+        memcpy(&ulWord, pucData, sizeof(uint64_t));
+        uCrc = __crc32d(uCrc, ulWord);
+    }
+    while(szDataSize-- != 0)
+        uCrc = __crc32b(uCrc, *pucData++);
+#else
+    const uint32_t (*puLut)[256] = gauiCrc32LUT;
+    for(; szDataSize >= 8; szDataSize -= 8, pucData += 8)
+    {
+        const uint32_t uLow = uCrc ^ ((uint32_t)pucData[0] | ((uint32_t)pucData[1] << 8) | ((uint32_t)pucData[2] << 16) | ((uint32_t)pucData[3] << 24));
+        uCrc = puLut[7][uLow & 0xFF] ^ puLut[6][(uLow >> 8) & 0xFF] ^ puLut[5][(uLow >> 16) & 0xFF] ^ puLut[4][uLow >> 24] ^
+               puLut[3][pucData[4]] ^ puLut[2][pucData[5]] ^ puLut[1][pucData[6]] ^ puLut[0][pucData[7]];
+    }
+    while(szDataSize-- != 0)
+        uCrc = (uCrc >> 8) ^ puLut[0][(uCrc & 0xFF) ^ *pucData++];
+#endif
+    return uCrc;
+}
 
 static uint32_t
 plu_str_hash_data(const void* pData, size_t szDataSize, uint32_t uSeed)
 {
-    uint32_t uCrc = ~uSeed;
-    const unsigned char* pucData = (const unsigned char*)pData;
-    const uint32_t* puCrc32Lut = gauiCrc32LUT;
-    while (szDataSize-- != 0)
-        uCrc = (uCrc >> 8) ^ puCrc32Lut[(uCrc & 0xFF) ^ *pucData++];
-    return ~uCrc;  
+    return ~plu__crc32(~uSeed, (const unsigned char*)pData, szDataSize);
 }
 
+// szDataSize of 0 means null terminated; hashing restarts from the seed at
+// every "###" so only the text after the last one contributes to the id
 static uint32_t
 plu_str_hash(const char* pcData, size_t szDataSize, uint32_t uSeed)
 {
-    uSeed = ~uSeed;
-    uint32_t uCrc = uSeed;
-    const unsigned char* pucData = (const unsigned char*)pcData;
-    const uint32_t* puCrc32Lut = gauiCrc32LUT;
-    if (szDataSize != 0)
+    if(szDataSize == 0)
+        szDataSize = strlen(pcData);
+
+    // a run of '#' is consumed at once, the last "###" in it starts the id
+    const char* pcEnd = pcData + szDataSize;
+    const char* pcStart = pcData;
+    const char* pcHash = pcData;
+    while((pcHash = (const char*)memchr(pcHash, '#', (size_t)(pcEnd - pcHash))) != NULL)
     {
-        while (szDataSize-- != 0)
-        {
-            unsigned char c = *pucData++;
-            if (c == '#' && szDataSize >= 2 && pucData[0] == '#' && pucData[1] == '#')
-                uCrc = uSeed;
-            uCrc = (uCrc >> 8) ^ puCrc32Lut[(uCrc & 0xFF) ^ c];
-        }
+        const char* pcRunEnd = pcHash + 1;
+        while(pcRunEnd < pcEnd && *pcRunEnd == '#')
+            pcRunEnd++;
+        if(pcRunEnd - pcHash >= 3)
+            pcStart = pcRunEnd - 3;
+        pcHash = pcRunEnd;
     }
-    else
-    {
-        unsigned char c = *pucData++;
-        while (c)
-        {
-            if (c == '#' && pucData[0] == '#' && pucData[1] == '#')
-                uCrc = uSeed;
-            uCrc = (uCrc >> 8) ^ puCrc32Lut[(uCrc & 0xFF) ^ c];
-            c = *pucData;
-            pucData++;
-            
-        }
-    }
-    return ~uCrc;
+    return ~plu__crc32(~uSeed, (const unsigned char*)pcStart, (size_t)(pcEnd - pcStart));
+}
+
+// pre-hashed id ("*_id" widgets) or the label hashed against the id stack
+static inline uint32_t
+pl__widget_id(const plUiId* ptId, const char* pcLabel)
+{
+    return ptId ? *ptId : plu_str_hash(pcLabel, 0, plu_sb_top(gptCtx->sbuIdStack));
 }
 
 #define plu_string_min(Value1, Value2) ((Value1) > (Value2) ? (Value2) : (Value1))
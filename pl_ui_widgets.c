@@ -31,7 +31,7 @@ pl__input_text_calc_text_size_w(const plUiWChar* text_begin, const plUiWChar* te
         if (c == '\r')
             continue;
 
-        const float char_width = font->sbtGlyphs[font->sbuCodePoints[(plUiWChar)c]].xAdvance * scale;
+        const float char_width = pl__glyph_advance(font, (plUiWChar)c) * scale;
         line_width += char_width;
     }
 
@@ -53,7 +53,7 @@ pl__input_text_calc_text_size_w(const plUiWChar* text_begin, const plUiWChar* te
 
 static int     STB_TEXTEDIT_STRINGLEN(const plUiInputTextState* obj)                             { return obj->iCurrentLengthW; }
 static plUiWChar STB_TEXTEDIT_GETCHAR(const plUiInputTextState* obj, int idx)                      { return obj->sbTextW[idx]; }
-static float   STB_TEXTEDIT_GETWIDTH(plUiInputTextState* obj, int line_start_idx, int char_idx)  { plUiWChar c = obj->sbTextW[line_start_idx + char_idx]; if (c == '\n') return STB_TEXTEDIT_GETWIDTH_NEWLINE; return gptCtx->ptFont->sbtGlyphs[gptCtx->ptFont->sbuCodePoints[c]].xAdvance * (gptCtx->tStyle.fFontSize / gptCtx->ptFont->tConfig.fFontSize); }
+static float   STB_TEXTEDIT_GETWIDTH(plUiInputTextState* obj, int line_start_idx, int char_idx)  { plUiWChar c = obj->sbTextW[line_start_idx + char_idx]; if (c == '\n') return STB_TEXTEDIT_GETWIDTH_NEWLINE; return pl__glyph_advance(gptCtx->ptFont, c) * (gptCtx->tStyle.fFontSize / gptCtx->ptFont->tConfig.fFontSize); }
 static int     STB_TEXTEDIT_KEYTOTEXT(int key)                                                    { return key >= 0x200000 ? 0 : key; }
 static plUiWChar STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, plUiInputTextState* obj, int line_start_idx)
@@ -389,8 +389,8 @@ pl_button_behavior(const plRect* ptBox, uint32_t uHash, bool* pbOutHovered, bool
     return bPressed;
 }
 
-bool
-pl_button(const char* pcText)
+static bool
+pl__button(const plUiId* ptId, const char* pcText)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     plUiLayoutRow* ptCurrentRow = &ptWindow->tTempData.tCurrentLayoutRow;
@@ -399,7 +399,7 @@ pl_button(const char* pcText)
     bool bPressed = false;
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
-        const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcText);
         plRect tBoundingBox = plu_calculate_rect(tStartPos, tWidgetSize);
         const plRect* ptClipRect = pl_get_clip_rect(gptCtx->ptDrawlist);
         tBoundingBox = plu_rect_clip_full(&tBoundingBox, ptClipRect);
@@ -408,12 +408,12 @@ pl_button(const char* pcText)
         bool bHeld = false;
         bPressed = pl_button_behavior(&tBoundingBox, uHash, &bHovered, &bHeld);
 
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonHoveredCol);
-        else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonHoveredCol);
+        else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonCol);
 
         const plVec2 tTextSize = pl_ui_calculate_text_size(gptCtx->ptFont, gptCtx->tStyle.fFontSize, pcText, -1.0f);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         plVec2 tTextStartPos = {
@@ -433,7 +433,19 @@ pl_button(const char* pcText)
 }
 
 bool
-pl_selectable(const char* pcText, bool* bpValue)
+pl_button(const char* pcText)
+{
+    return pl__button(NULL, pcText);
+}
+
+bool
+pl_button_id(plUiId tId, const char* pcText)
+{
+    return pl__button(&tId, pcText);
+}
+
+static bool
+pl__selectable(const plUiId* ptId, const char* pcText, bool* bpValue)
 {
 
     // temporary hack
@@ -448,9 +460,9 @@ pl_selectable(const char* pcText, bool* bpValue)
     bool bPressed = false;
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
-        const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcText);
 
-        plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+        plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         const plVec2 tTextStartPos = {
@@ -470,11 +482,11 @@ pl_selectable(const char* pcText, bool* bpValue)
         if(bPressed)
             *bpValue = !*bpValue;
 
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tEndPos, gptCtx->tColorScheme.tHeaderActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tEndPos, gptCtx->tColorScheme.tHeaderHoveredCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tEndPos, gptCtx->tPackedColorScheme.uHeaderActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tEndPos, gptCtx->tPackedColorScheme.uHeaderHoveredCol);
 
         if(*bpValue)
-            pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tEndPos, gptCtx->tColorScheme.tHeaderCol);
+            pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tEndPos, gptCtx->tPackedColorScheme.uHeaderCol);
 
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, pcText, -1.0f);
     }
@@ -483,7 +495,19 @@ pl_selectable(const char* pcText, bool* bpValue)
 }
 
 bool
-pl_checkbox(const char* pcText, bool* bpValue)
+pl_selectable(const char* pcText, bool* bpValue)
+{
+    return pl__selectable(NULL, pcText, bpValue);
+}
+
+bool
+pl_selectable_id(plUiId tId, const char* pcText, bool* bpValue)
+{
+    return pl__selectable(&tId, pcText, bpValue);
+}
+
+static bool
+pl__checkbox(const plUiId* ptId, const char* pcText, bool* bpValue)
 {
     // temporary hack
     static bool bDummyState = true;
@@ -498,8 +522,8 @@ pl_checkbox(const char* pcText, bool* bpValue)
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
         const bool bOriginalValue = *bpValue;
-        const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
-        plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+        const uint32_t uHash = pl__widget_id(ptId, pcText);
+        plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
 
@@ -518,12 +542,12 @@ pl_checkbox(const char* pcText, bool* bpValue)
         if(bPressed)
             *bpValue = !bOriginalValue;
 
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgHoveredCol);
-        else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgHoveredCol);
+        else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgCol);
 
         if(*bpValue)
-            pl_add_line(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tCheckmarkCol, 2.0f);
+            pl_add_line_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uCheckmarkCol, 2.0f);
 
         // add label
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, pcText, -1.0f); 
@@ -533,7 +557,19 @@ pl_checkbox(const char* pcText, bool* bpValue)
 }
 
 bool
-pl_radio_button(const char* pcText, int* piValue, int iButtonValue)
+pl_checkbox(const char* pcText, bool* bpValue)
+{
+    return pl__checkbox(NULL, pcText, bpValue);
+}
+
+bool
+pl_checkbox_id(plUiId tId, const char* pcText, bool* bpValue)
+{
+    return pl__checkbox(&tId, pcText, bpValue);
+}
+
+static bool
+pl__radio_button(const plUiId* ptId, const char* pcText, int* piValue, int iButtonValue)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     plUiLayoutRow* ptCurrentRow = &ptWindow->tTempData.tCurrentLayoutRow;
@@ -543,9 +579,9 @@ pl_radio_button(const char* pcText, int* piValue, int iButtonValue)
     bool bPressed = false;
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
-        const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcText);
         const plVec2 tTextSize = pl_ui_calculate_text_size(gptCtx->ptFont, gptCtx->tStyle.fFontSize, pcText, -1.0f);
-        plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+        plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         const plVec2 tSize = {tTextSize.x + 2.0f * gptCtx->tStyle.tFramePadding.x + gptCtx->tStyle.tInnerSpacing.x + tWidgetSize.y, tWidgetSize.y};
@@ -567,12 +603,12 @@ pl_radio_button(const char* pcText, int* piValue, int iButtonValue)
         if(bPressed)
             *piValue = iButtonValue;
 
-        if(gptCtx->uActiveId == uHash)       pl_add_circle_filled(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 1.5f, gptCtx->tColorScheme.tFrameBgActiveCol, 12);
-        else if(gptCtx->uHoveredId == uHash) pl_add_circle_filled(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 1.5f, gptCtx->tColorScheme.tFrameBgHoveredCol, 12);
-        else                                 pl_add_circle_filled(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 1.5f, gptCtx->tColorScheme.tFrameBgCol, 12);
+        if(gptCtx->uActiveId == uHash)       pl_add_circle_filled_u32(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 1.5f, gptCtx->tPackedColorScheme.uFrameBgActiveCol, 0);
+        else if(gptCtx->uHoveredId == uHash) pl_add_circle_filled_u32(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 1.5f, gptCtx->tPackedColorScheme.uFrameBgHoveredCol, 0);
+        else                                 pl_add_circle_filled_u32(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 1.5f, gptCtx->tPackedColorScheme.uFrameBgCol, 0);
 
         if(*piValue == iButtonValue)
-            pl_add_circle_filled(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 2.5f, gptCtx->tColorScheme.tCheckmarkCol, 12);
+            pl_add_circle_filled_u32(ptWindow->ptFgLayer, (plVec2){tStartPos.x + tWidgetSize.y / 2.0f, tStartPos.y + tWidgetSize.y / 2.0f}, gptCtx->tStyle.fFontSize / 2.5f, gptCtx->tPackedColorScheme.uCheckmarkCol, 0);
 
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, pcText, -1.0f);
     }
@@ -581,17 +617,29 @@ pl_radio_button(const char* pcText, int* piValue, int iButtonValue)
 }
 
 bool
-pl_collapsing_header(const char* pcText)
+pl_radio_button(const char* pcText, int* piValue, int iButtonValue)
+{
+    return pl__radio_button(NULL, pcText, piValue, iButtonValue);
+}
+
+bool
+pl_radio_button_id(plUiId tId, const char* pcText, int* piValue, int iButtonValue)
+{
+    return pl__radio_button(&tId, pcText, piValue, iButtonValue);
+}
+
+static bool
+pl__collapsing_header(const plUiId* ptId, const char* pcText)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     plUiLayoutRow* ptCurrentRow = &ptWindow->tTempData.tCurrentLayoutRow;
     const plVec2 tWidgetSize = pl_calculate_item_size(pl_get_frame_height());
     const plVec2 tStartPos   = pl__ui_get_cursor_pos();
-    const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
+    const uint32_t uHash = pl__widget_id(ptId, pcText);
     bool* pbOpenState = pl_get_bool_ptr(&ptWindow->tStorage, uHash, false);
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
-        plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+        plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         const plVec2 tTextStartPos = {
@@ -609,9 +657,9 @@ pl_collapsing_header(const char* pcText)
         if(bPressed)
             *pbOpenState = !*pbOpenState;
 
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tHeaderActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tHeaderHoveredCol);
-        else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tHeaderCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uHeaderActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uHeaderHoveredCol);
+        else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uHeaderCol);
 
         if(*pbOpenState)
         {
@@ -638,6 +686,18 @@ pl_collapsing_header(const char* pcText)
     return *pbOpenState; 
 }
 
+bool
+pl_collapsing_header(const char* pcText)
+{
+    return pl__collapsing_header(NULL, pcText);
+}
+
+bool
+pl_collapsing_header_id(plUiId tId, const char* pcText)
+{
+    return pl__collapsing_header(&tId, pcText);
+}
+
 void
 pl_end_collapsing_header(void)
 {
@@ -645,8 +705,8 @@ pl_end_collapsing_header(void)
     ptWindow->tTempData.tCurrentLayoutRow = plu_sb_pop(ptWindow->sbtRowStack);
 }
 
-bool
-pl_tree_node(const char* pcText)
+static bool
+pl__tree_node(const plUiId* ptId, const char* pcText)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     plu_sb_push(ptWindow->sbtRowStack, ptWindow->tTempData.tCurrentLayoutRow);
@@ -654,13 +714,13 @@ pl_tree_node(const char* pcText)
     const plVec2 tWidgetSize = pl_calculate_item_size(pl_get_frame_height());
     const plVec2 tStartPos   = pl__ui_get_cursor_pos();
 
-    const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
+    const uint32_t uHash = pl__widget_id(ptId, pcText);
     
     bool* pbOpenState = pl_get_bool_ptr(&ptWindow->tStorage, uHash, false);
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
 
-        plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+        plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         plRect tBoundingBox = plu_calculate_rect(tStartPos, tWidgetSize);
@@ -673,8 +733,8 @@ pl_tree_node(const char* pcText)
         if(bPressed)
             *pbOpenState = !*pbOpenState;
 
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tHeaderActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tHeaderHoveredCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uHeaderActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uHeaderHoveredCol);
 
         if(*pbOpenState)
         {
@@ -711,6 +771,18 @@ pl_tree_node(const char* pcText)
     return *pbOpenState; 
 }
 
+bool
+pl_tree_node(const char* pcText)
+{
+    return pl__tree_node(NULL, pcText);
+}
+
+bool
+pl_tree_node_id(plUiId tId, const char* pcText)
+{
+    return pl__tree_node(&tId, pcText);
+}
+
 bool
 pl_tree_node_f(const char* pcFmt, ...)
 {
@@ -783,10 +855,10 @@ pl_begin_tab_bar(const char* pcText)
     gptCtx->ptCurrentTabBar->tCursorPos = tStartPos;
     gptCtx->ptCurrentTabBar->uCurrentIndex = 0u;
 
-    pl_add_line(ptWindow->ptFgLayer, 
+    pl_add_line_u32(ptWindow->ptFgLayer, 
         (plVec2){gptCtx->ptCurrentTabBar->tStartPos.x, gptCtx->ptCurrentTabBar->tStartPos.y + fFrameHeight},
         (plVec2){gptCtx->ptCurrentTabBar->tStartPos.x + tWidgetSize.x, gptCtx->ptCurrentTabBar->tStartPos.y + fFrameHeight},
-        gptCtx->tColorScheme.tButtonActiveCol, 1.0f);
+        gptCtx->tPackedColorScheme.uButtonActiveCol, 1.0f);
 
     pl_advance_cursor(tWidgetSize.x, fFrameHeight);
     return true;
@@ -818,7 +890,7 @@ pl_begin_tab(const char* pcText)
     const plVec2 tTextSize = pl_ui_calculate_text_size(gptCtx->ptFont, gptCtx->tStyle.fFontSize, pcText, -1.0f);
     const plVec2 tStartPos = ptTabBar->tCursorPos;
 
-    plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, pl_find_renderered_text_end(pcText, NULL), -1.0f);
+    plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcText, -1.0f);
     const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
     const plVec2 tFinalSize = {tTextSize.x + 2.0f * gptCtx->tStyle.tFramePadding.x, fFrameHeight};
@@ -838,10 +910,10 @@ pl_begin_tab(const char* pcText)
         ptTabBar->uNextValue = uHash;
     }
 
-    if(gptCtx->uActiveId== uHash)        pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonActiveCol);
-    else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonHoveredCol);
-    else if(ptTabBar->uValue == uHash)   pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonActiveCol);
-    else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tButtonCol);
+    if(gptCtx->uActiveId== uHash)        pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonActiveCol);
+    else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonHoveredCol);
+    else if(ptTabBar->uValue == uHash)   pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonActiveCol);
+    else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uButtonCol);
     
     pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, pcText, -1.0f);
 
@@ -871,7 +943,7 @@ pl_separator(void)
     const plVec2 tStartPos   = pl__ui_get_cursor_pos();
     const plVec2 tWidgetSize = pl_calculate_item_size(gptCtx->tStyle.tItemSpacing.y * 2.0f);
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
-        pl_add_line(ptWindow->ptFgLayer, tStartPos, (plVec2){tStartPos.x + tWidgetSize.x, tStartPos.y}, gptCtx->tColorScheme.tCheckmarkCol, 1.0f);
+        pl_add_line_u32(ptWindow->ptFgLayer, tStartPos, (plVec2){tStartPos.x + tWidgetSize.x, tStartPos.y}, gptCtx->tPackedColorScheme.uCheckmarkCol, 1.0f);
 
     pl_advance_cursor(tWidgetSize.x, tWidgetSize.y);
 }
@@ -924,7 +996,7 @@ pl_text_v(const char* pcFmt, va_list args)
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
         plu_vsprintf(acTempBuffer, pcFmt, args);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, acTempBuffer, pl_find_renderered_text_end(acTempBuffer, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, acTempBuffer, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, (plVec2){tStartPos.x, tStartPos.y + tStartPos.y + tWidgetSize.y / 2.0f - tTextActualCenter.y}, gptCtx->tColorScheme.tTextCol, acTempBuffer, -1.0f);
     }
@@ -951,7 +1023,7 @@ pl_color_text_v(plVec4 tColor, const char* pcFmt, va_list args)
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
         plu_vsprintf(acTempBuffer, pcFmt, args);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, acTempBuffer, pl_find_renderered_text_end(acTempBuffer, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, acTempBuffer, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, (plVec2){tStartPos.x, tStartPos.y + tStartPos.y + tWidgetSize.y / 2.0f - tTextActualCenter.y}, tColor, acTempBuffer, -1.0f);
     }
@@ -977,7 +1049,7 @@ pl_labeled_text_v(const char* pcLabel, const char* pcFmt, va_list args)
     if(pl__ui_should_render(&tStartPos, &tWidgetSize))
     {
         plu_vsprintf(acTempBuffer, pcFmt, args);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, acTempBuffer, pl_find_renderered_text_end(acTempBuffer, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, acTempBuffer, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         const plVec2 tStartLocation = {tStartPos.x, tStartPos.y + tStartPos.y + tWidgetSize.y / 2.0f - tTextActualCenter.y};
@@ -1047,7 +1119,7 @@ pl_input_text_ex(const char* pcLabel, const char* pcHint, char* pcBuffer, size_t
     const plVec2 tFrameStartPos = {floorf(tStartPos.x + (tWidgetSize.x / 3.0f)), tStartPos.y };
     const uint32_t uHash = plu_str_hash(pcLabel, 0, plu_sb_top(gptCtx->sbuIdStack));
 
-    const plRect tLabelTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, pl_find_renderered_text_end(pcLabel, NULL), -1.0f);
+    const plRect tLabelTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, -1.0f);
     const plVec2 tLabelTextActualCenter = plu_rect_center(&tLabelTextBounding);
 
     const plVec2 tFrameSize = { 2.0f * (tWidgetSize.x / 3.0f), tWidgetSize.y};
@@ -1680,7 +1752,7 @@ pl_input_text_ex(const char* pcLabel, const char* pcHint, char* pcBuffer, size_t
     if (!bIsMultiLine)
     {
         // RenderNavHighlight(frame_bb, id);
-        pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgCol);
+        pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgCol);
     }
 
 
@@ -1837,7 +1909,7 @@ pl_input_text_ex(const char* pcLabel, const char* pcHint, char* pcBuffer, size_t
                 else
                 {
                     plVec2 rect_size = pl__input_text_calc_text_size_w(p, text_selected_end, &p, NULL, true);
-                    if (rect_size.x <= 0.0f) rect_size.x = floorf(gptCtx->ptFont->sbtGlyphs[gptCtx->ptFont->sbuCodePoints[(plUiWChar)' ']].xAdvance * 0.50f); // So we can see selected empty lines
+                    if (rect_size.x <= 0.0f) rect_size.x = floorf(pl__glyph_advance(gptCtx->ptFont, ' ') * 0.50f); // So we can see selected empty lines
                     plRect rect = {
                         plu_add_vec2(rect_pos, (plVec2){0.0f, bg_offy_up - gptCtx->tStyle.fFontSize}), 
                         plu_add_vec2(rect_pos, (plVec2){rect_size.x, bg_offy_dn})
@@ -1872,7 +1944,7 @@ pl_input_text_ex(const char* pcLabel, const char* pcHint, char* pcBuffer, size_t
                 {cursor_screen_pos.x + 1.0f, cursor_screen_pos.y - 1.5f}
             };
             if (bCursorIsVisible && plu_rect_overlaps_rect(&cursor_screen_rect, &clip_rect))
-                pl_add_line(ptWindow->ptFgLayer, cursor_screen_rect.tMin, plu_rect_bottom_left(&cursor_screen_rect), gptCtx->tColorScheme.tTextCol, 1.0f);
+                pl_add_line_u32(ptWindow->ptFgLayer, cursor_screen_rect.tMin, plu_rect_bottom_left(&cursor_screen_rect), gptCtx->tPackedColorScheme.uTextCol, 1.0f);
 
             // Notify OS of text input position for advanced IME (-1 x offset so that Windows IME can cover our cursor. Bit of an extra nicety.)
             // if (!bIsReadOnly)
@@ -1947,8 +2019,8 @@ pl_slider_float(const char* pcLabel, float* pfValue, float fMin, float fMax)
     return pl_slider_float_f(pcLabel, pfValue, fMin, fMax, "%0.3f");
 }
 
-bool
-pl_slider_float_f(const char* pcLabel, float* pfValue, float fMin, float fMax, const char* pcFormat)
+static bool
+pl__slider_float(const plUiId* ptId, const char* pcLabel, float* pfValue, float fMin, float fMax, const char* pcFormat)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     const plVec2 tWidgetSize = pl_calculate_item_size(pl_get_frame_height());
@@ -1959,12 +2031,12 @@ pl_slider_float_f(const char* pcLabel, float* pfValue, float fMin, float fMax, c
     {
         const plVec2 tFrameStartPos = {floorf(tStartPos.x + (tWidgetSize.x / 3.0f)), tStartPos.y };
         *pfValue = plu_clampf(fMin, *pfValue, fMax);
-        const uint32_t uHash = plu_str_hash(pcLabel, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcLabel);
 
         char acTextBuffer[64] = {0};
         plu_sprintf(acTextBuffer, pcFormat, *pfValue);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, acTextBuffer, pl_find_renderered_text_end(acTextBuffer, NULL), -1.0f);
-        const plRect tLabelTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, pl_find_renderered_text_end(pcLabel, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, acTextBuffer, -1.0f);
+        const plRect tLabelTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
         const plVec2 tLabelTextActualCenter = plu_rect_center(&tLabelTextBounding);
 
@@ -1991,11 +2063,11 @@ pl_slider_float_f(const char* pcLabel, float* pfValue, float fMin, float fMax, c
         const bool bPressed = pl_button_behavior(&tGrabBox, uHash, &bHovered, &bHeld);
 
         const plRect tBoundingBox = plu_calculate_rect(tFrameStartPos, tSize);
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgHoveredCol);
-        else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgHoveredCol);
+        else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgCol);
 
-        pl_add_rect_filled(ptWindow->ptFgLayer, tGrabStartPos, tGrabBox.tMax, gptCtx->tColorScheme.tButtonCol);
+        pl_add_rect_filled_u32(ptWindow->ptFgLayer, tGrabStartPos, tGrabBox.tMax, gptCtx->tPackedColorScheme.uButtonCol);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, (plVec2){tStartPos.x, tStartPos.y + tStartPos.y + tWidgetSize.y / 2.0f - tLabelTextActualCenter.y}, gptCtx->tColorScheme.tTextCol, pcLabel, -1.0f);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, acTextBuffer, -1.0f);
 
@@ -2013,14 +2085,32 @@ pl_slider_float_f(const char* pcLabel, float* pfValue, float fMin, float fMax, c
     return fOriginalValue != *pfValue;
 }
 
+bool
+pl_slider_float_f(const char* pcLabel, float* pfValue, float fMin, float fMax, const char* pcFormat)
+{
+    return pl__slider_float(NULL, pcLabel, pfValue, fMin, fMax, pcFormat);
+}
+
+bool
+pl_slider_float_id(plUiId tId, const char* pcLabel, float* pfValue, float fMin, float fMax)
+{
+    return pl__slider_float(&tId, pcLabel, pfValue, fMin, fMax, "%0.3f");
+}
+
+bool
+pl_slider_float_id_f(plUiId tId, const char* pcLabel, float* pfValue, float fMin, float fMax, const char* pcFormat)
+{
+    return pl__slider_float(&tId, pcLabel, pfValue, fMin, fMax, pcFormat);
+}
+
 bool
 pl_slider_int(const char* pcLabel, int* piValue, int iMin, int iMax)
 {
     return pl_slider_int_f(pcLabel, piValue, iMin, iMax, "%d");
 }
 
-bool
-pl_slider_int_f(const char* pcLabel, int* piValue, int iMin, int iMax, const char* pcFormat)
+static bool
+pl__slider_int(const plUiId* ptId, const char* pcLabel, int* piValue, int iMin, int iMax, const char* pcFormat)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     const plVec2 tWidgetSize = pl_calculate_item_size(pl_get_frame_height());
@@ -2032,14 +2122,14 @@ pl_slider_int_f(const char* pcLabel, int* piValue, int iMin, int iMax, const cha
         const plVec2 tFrameStartPos = {floorf(tStartPos.x + (tWidgetSize.x / 3.0f)), tStartPos.y };
 
         *piValue = plu_clampi(iMin, *piValue, iMax);
-        const uint32_t uHash = plu_str_hash(pcLabel, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcLabel);
         const int iBlocks = iMax - iMin + 1;
         const int iBlock = *piValue - iMin;
 
         char acTextBuffer[64] = {0};
         plu_sprintf(acTextBuffer, pcFormat, *piValue);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, acTextBuffer, pl_find_renderered_text_end(acTextBuffer, NULL), -1.0f);
-        const plRect tLabelTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, pl_find_renderered_text_end(pcLabel, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, acTextBuffer, -1.0f);
+        const plRect tLabelTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
         const plVec2 tLabelTextActualCenter = plu_rect_center(&tLabelTextBounding);
 
@@ -2064,11 +2154,11 @@ pl_slider_int_f(const char* pcLabel, int* piValue, int iMin, int iMax, const cha
         const bool bPressed = pl_button_behavior(&tGrabBox, uHash, &bHovered, &bHeld);
 
         const plRect tBoundingBox = plu_calculate_rect(tFrameStartPos, tSize);
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgHoveredCol);
-        else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgHoveredCol);
+        else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgCol);
 
-        pl_add_rect_filled(ptWindow->ptFgLayer, tGrabStartPos, tGrabBox.tMax, gptCtx->tColorScheme.tButtonCol);
+        pl_add_rect_filled_u32(ptWindow->ptFgLayer, tGrabStartPos, tGrabBox.tMax, gptCtx->tPackedColorScheme.uButtonCol);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, (plVec2){tStartPos.x, tStartPos.y + tStartPos.y + tWidgetSize.y / 2.0f - tLabelTextActualCenter.y}, gptCtx->tColorScheme.tTextCol, pcLabel, -1.0f);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, acTextBuffer, -1.0f);
 
@@ -2089,14 +2179,32 @@ pl_slider_int_f(const char* pcLabel, int* piValue, int iMin, int iMax, const cha
     return iOriginalValue != *piValue;
 }
 
+bool
+pl_slider_int_f(const char* pcLabel, int* piValue, int iMin, int iMax, const char* pcFormat)
+{
+    return pl__slider_int(NULL, pcLabel, piValue, iMin, iMax, pcFormat);
+}
+
+bool
+pl_slider_int_id(plUiId tId, const char* pcLabel, int* piValue, int iMin, int iMax)
+{
+    return pl__slider_int(&tId, pcLabel, piValue, iMin, iMax, "%d");
+}
+
+bool
+pl_slider_int_id_f(plUiId tId, const char* pcLabel, int* piValue, int iMin, int iMax, const char* pcFormat)
+{
+    return pl__slider_int(&tId, pcLabel, piValue, iMin, iMax, pcFormat);
+}
+
 bool
 pl_drag_float(const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax)
 {
     return pl_drag_float_f(pcLabel, pfValue, fSpeed, fMin, fMax, "%.3f");
 }
 
-bool
-pl_drag_float_f(const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax, const char* pcFormat)
+static bool
+pl__drag_float(const plUiId* ptId, const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax, const char* pcFormat)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     plUiLayoutRow* ptCurrentRow = &ptWindow->tTempData.tCurrentLayoutRow;
@@ -2108,12 +2216,12 @@ pl_drag_float_f(const char* pcLabel, float* pfValue, float fSpeed, float fMin, f
         const plVec2 tFrameStartPos = {floorf(tStartPos.x + (tWidgetSize.x / 3.0f)), tStartPos.y };
 
         *pfValue = plu_clampf(fMin, *pfValue, fMax);
-        const uint32_t uHash = plu_str_hash(pcLabel, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcLabel);
 
         char acTextBuffer[64] = {0};
         plu_sprintf(acTextBuffer, pcFormat, *pfValue);
-        const plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, acTextBuffer, pl_find_renderered_text_end(acTextBuffer, NULL), -1.0f);
-        const plRect tLabelTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, pl_find_renderered_text_end(pcLabel, NULL), -1.0f);
+        const plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, acTextBuffer, -1.0f);
+        const plRect tLabelTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tFrameStartPos, pcLabel, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
         const plVec2 tLabelTextActualCenter = plu_rect_center(&tLabelTextBounding);
 
@@ -2130,9 +2238,9 @@ pl_drag_float_f(const char* pcLabel, float* pfValue, float fSpeed, float fMin, f
         bool bHeld = false;
         const bool bPressed = pl_button_behavior(&tBoundingBox, uHash, &bHovered, &bHeld);
 
-        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgActiveCol);
-        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgHoveredCol);
-        else                                 pl_add_rect_filled(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tColorScheme.tFrameBgCol);
+        if(gptCtx->uActiveId == uHash)       pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgActiveCol);
+        else if(gptCtx->uHoveredId == uHash) pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgHoveredCol);
+        else                                 pl_add_rect_filled_u32(ptWindow->ptFgLayer, tFrameStartPos, tBoundingBox.tMax, gptCtx->tPackedColorScheme.uFrameBgCol);
 
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, (plVec2){tStartPos.x, tStartPos.y + tStartPos.y + tWidgetSize.y / 2.0f - tLabelTextActualCenter.y}, gptCtx->tColorScheme.tTextCol, pcLabel, -1.0f);
         pl_ui_add_text(ptWindow->ptFgLayer, gptCtx->ptFont, gptCtx->tStyle.fFontSize, tTextStartPos, gptCtx->tColorScheme.tTextCol, acTextBuffer, -1.0f);
@@ -2148,6 +2256,24 @@ pl_drag_float_f(const char* pcLabel, float* pfValue, float fSpeed, float fMin, f
     return fOriginalValue != *pfValue;    
 }
 
+bool
+pl_drag_float_f(const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax, const char* pcFormat)
+{
+    return pl__drag_float(NULL, pcLabel, pfValue, fSpeed, fMin, fMax, pcFormat);
+}
+
+bool
+pl_drag_float_id(plUiId tId, const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax)
+{
+    return pl__drag_float(&tId, pcLabel, pfValue, fSpeed, fMin, fMax, "%.3f");
+}
+
+bool
+pl_drag_float_id_f(plUiId tId, const char* pcLabel, float* pfValue, float fSpeed, float fMin, float fMax, const char* pcFormat)
+{
+    return pl__drag_float(&tId, pcLabel, pfValue, fSpeed, fMin, fMax, pcFormat);
+}
+
 void
 pl_image(plTextureId tTexture, plVec2 tSize)
 {
@@ -2211,8 +2337,8 @@ pl_image_button_ex(const char* pcId, plTextureId tTexture, plVec2 tSize, plVec2
     return bPressed;
 }
 
-bool
-pl_invisible_button(const char* pcText, plVec2 tSize)
+static bool
+pl__invisible_button(const plUiId* ptId, const char* pcText, plVec2 tSize)
 {
     plUiWindow* ptWindow = gptCtx->ptCurrentWindow;
     plUiLayoutRow* ptCurrentRow = &ptWindow->tTempData.tCurrentLayoutRow;
@@ -2221,7 +2347,7 @@ pl_invisible_button(const char* pcText, plVec2 tSize)
     bool bPressed = false;
     if(!(tStartPos.y + tSize.y < ptWindow->tPos.y || tStartPos.y > ptWindow->tPos.y + ptWindow->tFullSize.y))
     {
-        const uint32_t uHash = plu_str_hash(pcText, 0, plu_sb_top(gptCtx->sbuIdStack));
+        const uint32_t uHash = pl__widget_id(ptId, pcText);
         plRect tBoundingBox = plu_calculate_rect(tStartPos, tSize);
         const plRect* ptClipRect = pl_get_clip_rect(gptCtx->ptDrawlist);
         tBoundingBox = plu_rect_clip_full(&tBoundingBox, ptClipRect);
@@ -2234,6 +2360,18 @@ pl_invisible_button(const char* pcText, plVec2 tSize)
     return bPressed;  
 }
 
+bool
+pl_invisible_button(const char* pcText, plVec2 tSize)
+{
+    return pl__invisible_button(NULL, pcText, tSize);
+}
+
+bool
+pl_invisible_button_id(plUiId tId, plVec2 tSize)
+{
+    return pl__invisible_button(&tId, NULL, tSize);
+}
+
 void
 pl_dummy(plVec2 tSize)
 {
@@ -2256,8 +2394,8 @@ pl_progress_bar(float fFraction, plVec2 tSize, const char* pcOverlay)
     if(!(tStartPos.y + tSize.y < ptWindow->tPos.y || tStartPos.y > ptWindow->tPos.y + ptWindow->tFullSize.y))
     {
 
-        pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, plu_add_vec2(tStartPos, tSize), gptCtx->tColorScheme.tFrameBgCol);
-        pl_add_rect_filled(ptWindow->ptFgLayer, tStartPos, plu_add_vec2(tStartPos, (plVec2){tSize.x * fFraction, tSize.y}), gptCtx->tColorScheme.tProgressBarCol);
+        pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, plu_add_vec2(tStartPos, tSize), gptCtx->tPackedColorScheme.uFrameBgCol);
+        pl_add_rect_filled_u32(ptWindow->ptFgLayer, tStartPos, plu_add_vec2(tStartPos, (plVec2){tSize.x * fFraction, tSize.y}), gptCtx->tPackedColorScheme.uProgressBarCol);
 
         const char* pcTextPtr = pcOverlay;
         
@@ -2269,7 +2407,7 @@ pl_progress_bar(float fFraction, plVec2 tSize, const char* pcOverlay)
         }
 
         const plVec2 tTextSize = pl_ui_calculate_text_size(gptCtx->ptFont, gptCtx->tStyle.fFontSize, pcTextPtr, -1.0f);
-        plRect tTextBounding = pl_calculate_text_bb_ex(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcTextPtr, pl_find_renderered_text_end(pcTextPtr, NULL), -1.0f);
+        plRect tTextBounding = pl_ui_calculate_text_bb(gptCtx->ptFont, gptCtx->tStyle.fFontSize, tStartPos, pcTextPtr, -1.0f);
         const plVec2 tTextActualCenter = plu_rect_center(&tTextBounding);
 
         plVec2 tTextStartPos = {